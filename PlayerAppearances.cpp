@@ -3,20 +3,18 @@
 #include "PlayerAppearances.h"
 #include "GlobalLogger.h"
 
+#include "FBB/FBBCSVReader.h"
+
 #include <vector>
 #include <fstream>
 #include <bitset>
 #include <unordered_map>
-#include <boost/tokenizer.hpp>
+#include <sstream>
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 
-#include <boost/algorithm/string/classification.hpp>
-#include <boost/algorithm/string/replace.hpp>
-#include <boost/algorithm/string/split.hpp>
-
 #include <QFile>
 #include <QString>
-#include <QTextStream>
 
 PlayerApperances::PlayerApperances()
 {
@@ -26,53 +24,65 @@ PlayerApperances::PlayerApperances()
     // Open file
     QFile inputFile(":/data/2016_Appearances.csv");
     inputFile.open(QIODevice::ReadOnly);
-    QTextStream file(&inputFile);
-
-    // Tokenize header data
-    using Tokenizer = boost::tokenizer<boost::escaped_list_separator<char>>;
-    std::string row = file.readLine().toStdString();
-    Tokenizer tokenizer(row);
-
+    FBBCSVReader reader(inputFile.readAll());
+
+    // Skip header
+    reader.ReadRow();
+
+    // Column layout (baseball reference packs the id into the name as "Name\id")
+    enum
+    {
+        APPEARANCE_RK,
+        APPEARANCE_NAME_ID,
+        APPEARANCE_AGE,
+        APPEARANCE_TEAM,
+        APPEARANCE_EXP,
+        APPEARANCE_G,
+        APPEARANCE_GS,
+        APPEARANCE_C = 10,
+        APPEARANCE_1B,
+        APPEARANCE_2B,
+        APPEARANCE_3B,
+        APPEARANCE_SS,
+        APPEARANCE_OF = 18,
+        APPEARANCE_DH,
+
+        APPEARANCE_COUNT,
+    };
 
     // Loop rows
-    // while (std::getline(apperances, row)) {
-    while (!file.atEnd()) {
+    while (reader.ReadRow()) {
 
-        // Tokenization and/or lexical casts might fail if the data is malformed
+        // Lexical casts might fail if the data is malformed
         try {
 
-            // Tokenize this row
-            std::string row = file.readLine().toStdString();
-
-            // Baseball reference likes \ to delimit as well?
-            boost::replace_all(row, "\\", ",");
-
-            // Tokenize!
-            Tokenizer tokenizer(row);
-            std::vector<std::string> parsed(tokenizer.begin(), tokenizer.end());
+            if (reader.FieldCount() < APPEARANCE_COUNT) {
+                throw 0;
+            }
 
             // Parse name
-            std::string name = parsed[1];
-            std::string id   = parsed[2];
-            std::string team = parsed[4];
+            const FBBCSVField& nameId = reader[APPEARANCE_NAME_ID];
+            const char* pSplit = std::find(nameId.Data(), nameId.Data() + nameId.Size(), '\\');
+            std::string name(nameId.Data(), pSplit);
+            std::string team(reader[APPEARANCE_TEAM].Data(), reader[APPEARANCE_TEAM].Size());
 
             // Parse apperances
             Appearances apperances;
-            apperances.age  = boost::lexical_cast<uint32_t>(parsed[3]);
-            if (parsed[5] == "1st") {
+            apperances.age  = reader[APPEARANCE_AGE].ToUInt();
+            if (reader[APPEARANCE_EXP] == "1st") {
                 apperances.exp = 0;
             } else {
-                apperances.exp = boost::lexical_cast<uint32_t>(parsed[5]);
+                apperances.exp = boost::lexical_cast<uint32_t>(reader[APPEARANCE_EXP].Data(), reader[APPEARANCE_EXP].Size());
             }
-            apperances.G    = boost::lexical_cast<uint32_t>(parsed[6]);
-            apperances.GS   = boost::lexical_cast<uint32_t>(parsed[7]);
-            apperances.atC  = boost::lexical_cast<uint32_t>(parsed[11]);
-            apperances.at1B = boost::lexical_cast<uint32_t>(parsed[12]);
-            apperances.at2B = boost::lexical_cast<uint32_t>(parsed[13]);
-            apperances.at3B = boost::lexical_cast<uint32_t>(parsed[14]);
-            apperances.atSS = boost::lexical_cast<uint32_t>(parsed[15]);
-            apperances.atOF = boost::lexical_cast<uint32_t>(parsed[19]);
-            apperances.atDH = boost::lexical_cast<uint32_t>(parsed[20]);
+            apperances.G    = reader[APPEARANCE_G].ToUInt();
+            apperances.GS   = reader[APPEARANCE_GS].ToUInt();
+            apperances.atC  = reader[APPEARANCE_C].ToUInt();
+            apperances.at1B = reader[APPEARANCE_1B].ToUInt();
+            apperances.at2B = reader[APPEARANCE_2B].ToUInt();
+            apperances.at3B = reader[APPEARANCE_3B].ToUInt();
+            apperances.atSS = reader[APPEARANCE_SS].ToUInt();
+            apperances.atOF = reader[APPEARANCE_OF].ToUInt();
+            apperances.atDH = reader[APPEARANCE_DH].ToUInt();
 
             // Get key
             auto key = std::make_tuple(name, team);
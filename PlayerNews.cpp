@@ -1,16 +1,14 @@
 #include "PlayerNews.h"
 #include "GlobalLogger.h"
+#include "FBB/FBBCSVReader.h"
 
 #include <vector>
 #include <fstream>
 #include <bitset>
 #include <unordered_map>
-#include <boost/tokenizer.hpp>
-#include <boost/lexical_cast.hpp>
 
 #include <QFile>
 #include <QString>
-#include <QTextStream>
 
 PlayerNews::PlayerNews()
 {
@@ -20,44 +18,25 @@ PlayerNews::PlayerNews()
     // Open file
     QFile inputFile(":/data/News_2017.csv");
     inputFile.open(QIODevice::ReadOnly);
-    QTextStream file(&inputFile);
-
-    // CSV tokenizer
-    using Tokenizer = boost::tokenizer<boost::escaped_list_separator<char>>;
+    FBBCSVReader reader(inputFile.readAll());
 
     // Loop rows
-    while (!file.atEnd()) {
-
-        // Tokenization and/or lexical casts might fail if the data is malformed
-        try {
-
-            // Tokenize this row
-            std::string row = file.readLine().toStdString();
-            Tokenizer tokenizer(row);
-            std::vector<std::string> parsed(tokenizer.begin(), tokenizer.end());
-
-            // Parse name
-            std::string name = parsed.at(0);
-            std::string id = parsed.at(1);
-            std::string details = parsed.at(2);
-            std::string quick = parsed.at(3);
-            std::string news = parsed.at(4);
-
-            // Build news struct
-            std::shared_ptr<News> spNews = std::make_shared<News>();
-            spNews->details = QString::fromStdString(details);
-            spNews->quick = QString::fromStdString(quick);
-            spNews->news = QString::fromStdString(news);
+    while (reader.ReadRow()) {
 
-           // Save in database
-           m_mapNews[QString::fromStdString(id)] = std::move(spNews);
-
-        } catch (...) {
-
-            // Try next if something went wrong
+        // Try next if the row is malformed
+        if (reader.FieldCount() < 5) {
             GlobalLogger::AppendMessage(QString("Failed to parse news for a player"));
             continue;
         }
+
+        // Build news struct
+        std::shared_ptr<News> spNews = std::make_shared<News>();
+        spNews->details = reader[2].ToString();
+        spNews->quick = reader[3].ToString();
+        spNews->news = reader[4].ToString();
+
+        // Save in database
+        m_mapNews[reader[1].ToString()] = std::move(spNews);
     }
 }
 
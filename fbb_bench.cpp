@@ -0,0 +1,340 @@
+#include "FBB/FBBApplication.h"
+#include "FBB/FBBAuctionSimulator.h"
+#include "FBB/FBBCategory.h"
+#include "FBB/FBBDraftBoardModel.h"
+#include "FBB/FBBDraftBoardSortFilterProxyModel.h"
+#include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBPlayerStore.h"
+#include "FBB/FBBProjectionCache.h"
+#include "FBB/FBBProjectionService.h"
+#include "FBB/FBBSyntheticPool.h"
+#include "FBB/FBBTrace.h"
+
+#include <QCommandLineParser>
+#include <QEventLoop>
+#include <QFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Allocation counting
+//------------------------------------------------------------------------------
+// Every operator new in the process is counted. Qt containers allocate through
+// malloc directly and don't show up.
+static std::atomic<uint64_t> s_allocations(0);
+static std::atomic<uint64_t> s_allocatedBytes(0);
+
+void* operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+//------------------------------------------------------------------------------
+// Bench
+//------------------------------------------------------------------------------
+// Runs each benchmark a number of times and prints the best time, the time per
+// player and the allocations of an average run.
+class Bench
+{
+public:
+
+    Bench(uint32_t repeats) : m_repeats(repeats) {}
+
+    void PrintHeader() const
+    {
+        std::printf("%-40s %9s %11s %11s %12s %12s\n", "benchmark", "players", "best ms", "ns/player", "allocs/run", "KB/run");
+    }
+
+    template <typename Setup, typename Work>
+    void Run(const QString& name, uint64_t players, Setup setup, Work work)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double bestMs = std::numeric_limits<double>::max();
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        for (uint32_t i = 0; i < m_repeats; i++) {
+            setup();
+            const uint64_t allocationsBefore = s_allocations;
+            const uint64_t bytesBefore = s_allocatedBytes;
+            const Clock::time_point start = Clock::now();
+            work();
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            allocations += s_allocations - allocationsBefore;
+            bytes += s_allocatedBytes - bytesBefore;
+            bestMs = std::min(bestMs, ms);
+        }
+
+        const double nsPerPlayer = players ? bestMs * 1e6 / players : 0.0;
+        std::printf("%-40s %9llu %11.3f %11.1f %12.0f %12.1f\n",
+            name.toUtf8().constData(),
+            static_cast<unsigned long long>(players),
+            bestMs,
+            nsPerPlayer,
+            double(allocations) / m_repeats,
+            double(bytes) / m_repeats / 1024.0);
+        std::fflush(stdout);
+    }
+
+    template <typename Work>
+    void Run(const QString& name, uint64_t players, Work work)
+    {
+        Run(name, players, []() {}, work);
+    }
+
+private:
+    uint32_t m_repeats;
+};
+
+// Keeps the filter results alive
+static volatile uint64_t s_sink = 0;
+
+// Stops the auction simulation a board reset starts, so it doesn't compete
+// with the benchmarks that follow
+static void CancelSimulation()
+{
+    if (FBBAuctionSimulator* pSimulator = fbbApp->DraftBoardModel()->findChild<FBBAuctionSimulator*>()) {
+        pSimulator->Cancel();
+    }
+}
+
+// Loads the projections and waits for the board to be valued
+static void LoadProjections(FBBProjectionService::LoadMode mode, bool useSnapshot)
+{
+    if (!useSnapshot) {
+        QFile::remove(FBBProjectionCache::SnapshotPath());
+    }
+
+    FBBProjectionService& service = FBBProjectionService::Instance();
+    service.SetLoadMode(mode);
+
+    QEventLoop loop;
+    QObject::connect(&service, &FBBProjectionService::ProjectionsLoaded, &loop, &QEventLoop::quit);
+    service.LoadProjections();
+    loop.exec();
+    CancelSimulation();
+}
+
+static std::vector<uint32_t> ValidRows(FBBPlayerStore* pStore, FBBPlayer::PlayerType type)
+{
+    std::vector<uint32_t> vecRows;
+    for (uint32_t row = 0; row < pStore->Count(type); row++) {
+        if (pStore->Player(type, row)->IsValidUnderCurrentSettings()) {
+            vecRows.push_back(row);
+        }
+    }
+    return vecRows;
+}
+
+// Valuation, filtering and sorting of the board over a player pool
+static void BenchBoard(Bench& bench, const QString& pool, FBBPlayerStore* pStore)
+{
+    FBBDraftBoardModel* pModel = fbbApp->DraftBoardModel();
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    const uint64_t numPlayers = pStore->Count(FBBPlayer::PLAYER_TYPE_HITTER) + pStore->Count(FBBPlayer::PLAYER_TYPE_PITCHER);
+
+    // Valuation
+    bench.Run(pool + " reset board", numPlayers, [&]() {
+        pModel->Reset(pStore);
+        CancelSimulation();
+    });
+
+    for (FBBPlayer::PlayerType type : { FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::PLAYER_TYPE_PITCHER }) {
+        FBBPlayerColumns& columns = pStore->Columns(type);
+        const std::vector<uint32_t> vecRows = ValidRows(pStore, type);
+        const std::vector<const FBBCategory*> vecCategories = FBBEnabledCategories(type, pSettings->categories);
+        const QString name = type == FBBPlayer::PLAYER_TYPE_HITTER ? " z-scores hitting" : " z-scores pitching";
+        bench.Run(pool + name, vecRows.size(), [&]() {
+            FBBCalculateZScores(columns, type, vecCategories, vecRows);
+        });
+    }
+
+    bench.Run(pool + " recalculate", numPlayers, [&]() {
+        pModel->Recalculate();
+        CancelSimulation();
+    });
+
+    // Filtering: every row through filterAcceptsRow under a few filters
+    FBBDraftBoardSortFilterProxyModel proxy;
+    proxy.setSourceModel(pModel);
+
+    struct Filter
+    {
+        const char* name;
+        bool onlyHitters;
+        bool onlyPitchers;
+        FBBPositionMask positions;
+    };
+
+    // The board's own masks: enabled positions for "all", every bit for
+    // hitters and pitchers
+    const FBBPositionMask allPositions = pSettings->EnabledPositions();
+    const Filter filters[] =
+    {
+        { "all", false, false, allPositions },
+        { "hitters", true, false, ~FBBPositionMask(0) },
+        { "pitchers", false, true, ~FBBPositionMask(0) },
+        { "C", true, false, FBB_POSITION_C },
+        { "SP", false, true, FBB_POSITION_SP },
+    };
+
+    const int numRows = pModel->rowCount();
+    for (const Filter& filter : filters) {
+        proxy.SetOnlyHitters(filter.onlyHitters);
+        proxy.SetOnlyPitchers(filter.onlyPitchers);
+        proxy.SetPositionFilter(filter.positions);
+        bench.Run(pool + " filter " + filter.name, numRows, [&]() {
+            uint64_t accepted = 0;
+            for (int row = 0; row < numRows; row++) {
+                accepted += proxy.filterAcceptsRow(row, QModelIndex());
+            }
+            s_sink = accepted;
+        });
+    }
+
+    // Sorting: every column from the model's order
+    proxy.SetOnlyHitters(false);
+    proxy.SetOnlyPitchers(false);
+    proxy.SetPositionFilter(allPositions);
+    proxy.SetShowDrafted(true);
+
+    const size_t numValid = ValidRows(pStore, FBBPlayer::PLAYER_TYPE_HITTER).size() + ValidRows(pStore, FBBPlayer::PLAYER_TYPE_PITCHER).size();
+    if (size_t(proxy.rowCount()) != numValid) {
+        std::fprintf(stderr, "Sorting %d of %zu valid players\n", proxy.rowCount(), numValid);
+    }
+    for (int column = 0; column < FBBDraftBoardModel::COLUMN_COUNT; column++) {
+        QString header = pModel->headerData(column, Qt::Horizontal, Qt::DisplayRole).toString();
+        if (header.isEmpty()) {
+            header = QString::number(column);
+        }
+        bench.Run(pool + " sort " + header, proxy.rowCount(), [&]() {
+            proxy.sort(-1);
+        }, [&]() {
+            proxy.sort(column, Qt::AscendingOrder);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // No display needed
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // Keep the projection snapshot away from the application's own cache
+    QStandardPaths::setTestModeEnabled(true);
+
+    FBBApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times loading, valuation, filtering and sorting of the draft board.");
+    parser.addHelpOption();
+    const QCommandLineOption repeatOption("repeat", "Runs per benchmark (the best time is reported).", "count", "5");
+    const QCommandLineOption sizesOption("sizes", "Comma separated synthetic pool sizes.", "sizes", "1000,10000,100000");
+    const QCommandLineOption seedOption("seed", "Seed of the synthetic pools.", "seed", "2019");
+    const QCommandLineOption noBundledOption("no-bundled", "Skip the bundled 2019 projections.");
+    const QCommandLineOption dataOption("data", "Load projections and league from a directory (see fbb_synth) instead of the bundled ones.", "dir");
+    const QCommandLineOption traceOption("trace", "Write the trace events of the run to a file.", "file");
+    parser.addOption(repeatOption);
+    parser.addOption(sizesOption);
+    parser.addOption(seedOption);
+    parser.addOption(noBundledOption);
+    parser.addOption(dataOption);
+    parser.addOption(traceOption);
+    parser.process(app);
+
+    Bench bench(std::max(1u, parser.value(repeatOption).toUInt()));
+    bench.PrintHeader();
+
+    // Bundled (or given) projections: parsing in both modes, then from the
+    // snapshot the parse leaves behind
+    if (!parser.isSet(noBundledOption) || parser.isSet(dataOption)) {
+        const QString data = parser.isSet(dataOption) ? "data" : "2019";
+        if (parser.isSet(dataOption)) {
+            app.LoadDataDirectory(parser.value(dataOption));
+        }
+
+        LoadProjections(FBBProjectionService::LoadMode::Parallel, false);
+        FBBPlayerStore* pStore = FBBProjectionService::Instance().Store();
+        const uint64_t numPlayers = pStore->Count(FBBPlayer::PLAYER_TYPE_HITTER) + pStore->Count(FBBPlayer::PLAYER_TYPE_PITCHER);
+
+        bench.Run(data + " load (serial parse)", numPlayers, []() {
+            LoadProjections(FBBProjectionService::LoadMode::Serial, false);
+        });
+        bench.Run(data + " load (parallel parse)", numPlayers, []() {
+            LoadProjections(FBBProjectionService::LoadMode::Parallel, false);
+        });
+        bench.Run(data + " load (snapshot)", numPlayers, []() {
+            LoadProjections(FBBProjectionService::LoadMode::Parallel, true);
+        });
+
+        BenchBoard(bench, data, FBBProjectionService::Instance().Store());
+    }
+
+    // Synthetic pools, split like the bundled data between hitters and pitchers
+    const uint64_t seed = parser.value(seedOption).toULongLong();
+    for (const QString& size : parser.value(sizesOption).split(',', QString::SkipEmptyParts)) {
+        const uint32_t numPlayers = size.toUInt();
+        if (numPlayers == 0) {
+            continue;
+        }
+
+        FBBSyntheticPool::Options options;
+        options.numHitters = numPlayers * 4 / 9;
+        options.numPitchers = numPlayers - options.numHitters;
+        options.seed = seed;
+
+        FBBPlayerStore store;
+        FBBSyntheticPool::Generate(store, options);
+        BenchBoard(bench, QString("synthetic %1").arg(numPlayers), &store);
+
+        // Let go of the pool before it's destroyed
+        fbbApp->DraftBoardModel()->Reset(nullptr);
+        CancelSimulation();
+    }
+
+    if (parser.isSet(traceOption) && !FBBTrace::Write(parser.value(traceOption))) {
+        std::fprintf(stderr, "Can't write %s\n", qPrintable(parser.value(traceOption)));
+        return 1;
+    }
+
+    return 0;
+}
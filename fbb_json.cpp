@@ -1,8 +1,9 @@
 #include <QCoreApplication>
 
+#include "FBB/FBBCSVReader.h"
+
 #include <cstdint>
 #include <QFile>
-#include <QTextStream>
 #include <QString>
 #include <QMap>
 
@@ -39,11 +40,10 @@ static std::vector<Hitter> hitters_steamer()
     // Open file
     QFile inputFile(":/data/2019-hitters-fan.csv");
     inputFile.open(QIODevice::ReadOnly);
-    QTextStream textStream(&inputFile);
+    FBBCSVReader reader(inputFile.readAll());
 
-    // Tokenize header data
-    QStringList parsed = textStream.readLine().split(",");
-    parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    // Skip header
+    reader.ReadRow();
 
     enum SteamerHitter
     {
@@ -113,30 +113,26 @@ static std::vector<Hitter> hitters_steamer()
     };
 
     // Loop rows
-    while (!textStream.atEnd()) {
-
-        // Tokenize this row
-        QStringList parsed = textStream.readLine().split(",");
-        parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    while (reader.ReadRow()) {
 
         Hitter hitter;
-        hitter._NAME = parsed[FAN_HITTER_NAME];
-        hitter._TEAM = parsed[FAN_HITTER_TEAM];
-        hitter._ID   = parsed[FAN_HITTER_PLAYER_ID];
-        hitter._G    = parsed[FAN_HITTER_G].toInt();
-        hitter._PA   = parsed[FAN_HITTER_PA].toInt();
-        hitter._AB   = parsed[FAN_HITTER_AB].toInt();
-        hitter._H    = parsed[FAN_HITTER_H].toInt();
-        hitter._2B   = parsed[FAN_HITTER_2B].toInt();
-        hitter._3B   = parsed[FAN_HITTER_3B].toInt();
-        hitter._HR   = parsed[FAN_HITTER_HR].toInt();
-        hitter._R    = parsed[FAN_HITTER_R].toInt();
-        hitter._RBI  = parsed[FAN_HITTER_RBI].toInt();
-        hitter._xBB  = parsed[FAN_HITTER_BB].toInt();
-        hitter._SO   = parsed[FAN_HITTER_SO].toInt();
-        hitter._HBP  = parsed[FAN_HITTER_HBP].toInt();
-        hitter._SB   = parsed[FAN_HITTER_SB].toInt();
-        hitter._CS   = parsed[FAN_HITTER_CS].toInt();
+        hitter._NAME = reader[FAN_HITTER_NAME].ToString();
+        hitter._TEAM = reader[FAN_HITTER_TEAM].ToString();
+        hitter._ID   = reader[FAN_HITTER_PLAYER_ID].ToString();
+        hitter._G    = reader[FAN_HITTER_G].ToUInt();
+        hitter._PA   = reader[FAN_HITTER_PA].ToUInt();
+        hitter._AB   = reader[FAN_HITTER_AB].ToUInt();
+        hitter._H    = reader[FAN_HITTER_H].ToUInt();
+        hitter._2B   = reader[FAN_HITTER_2B].ToUInt();
+        hitter._3B   = reader[FAN_HITTER_3B].ToUInt();
+        hitter._HR   = reader[FAN_HITTER_HR].ToUInt();
+        hitter._R    = reader[FAN_HITTER_R].ToUInt();
+        hitter._RBI  = reader[FAN_HITTER_RBI].ToUInt();
+        hitter._xBB  = reader[FAN_HITTER_BB].ToUInt();
+        hitter._SO   = reader[FAN_HITTER_SO].ToUInt();
+        hitter._HBP  = reader[FAN_HITTER_HBP].ToUInt();
+        hitter._SB   = reader[FAN_HITTER_SB].ToUInt();
+        hitter._CS   = reader[FAN_HITTER_CS].ToUInt();
         ret.push_back(hitter);
     }
 
@@ -172,11 +168,10 @@ static std::vector<Pitcher> pitchers_steamer()
     // Open file
     QFile inputFile(":/data/2019-pitchers-fan.csv");
     inputFile.open(QIODevice::ReadOnly);
-    QTextStream textStream(&inputFile);
+    FBBCSVReader reader(inputFile.readAll());
 
-    // Tokenize header data
-    QStringList parsed = textStream.readLine().split(",");
-    parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    // Skip header
+    reader.ReadRow();
 
     enum SteamerPitcher
     {
@@ -231,28 +226,24 @@ static std::vector<Pitcher> pitchers_steamer()
     };
 
     // Loop rows
-    while (!textStream.atEnd()) {
-
-        // Tokenize this row
-        QStringList parsed = textStream.readLine().split(",");
-        parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    while (reader.ReadRow()) {
 
         Pitcher pitcher;
-        pitcher._NAME = parsed[FAN_PITCHER_NAME];
-        pitcher._TEAM = parsed[FAN_PITCHER_TEAM];
-        pitcher._ID   = parsed[FAN_PITCHER_PLAYER_ID];
-        pitcher._W    = parsed[FAN_PITCHER_W].toInt();
-        pitcher._L    = parsed[FAN_PITCHER_L].toInt();
-        pitcher._ERA  = parsed[FAN_PITCHER_ERA].toInt();
-        pitcher._GS   = parsed[FAN_PITCHER_GS].toInt();
-        pitcher._G    = parsed[FAN_PITCHER_G].toInt();
-        pitcher._SV   = parsed[FAN_PITCHER_SV].toInt();
-        pitcher._IP   = parsed[FAN_PITCHER_IP].toInt();
-        pitcher._H    = parsed[FAN_PITCHER_H].toInt();
-        pitcher._ER   = parsed[FAN_PITCHER_ER].toInt();
-        pitcher._HR   = parsed[FAN_PITCHER_HR].toInt();
-        pitcher._SO   = parsed[FAN_PITCHER_SO].toInt();
-        pitcher._xBB  = parsed[FAN_PITCHER_BB].toInt();
+        pitcher._NAME = reader[FAN_PITCHER_NAME].ToString();
+        pitcher._TEAM = reader[FAN_PITCHER_TEAM].ToString();
+        pitcher._ID   = reader[FAN_PITCHER_PLAYER_ID].ToString();
+        pitcher._W    = reader[FAN_PITCHER_W].ToUInt();
+        pitcher._L    = reader[FAN_PITCHER_L].ToUInt();
+        pitcher._ERA  = reader[FAN_PITCHER_ERA].ToUInt();
+        pitcher._GS   = reader[FAN_PITCHER_GS].ToUInt();
+        pitcher._G    = reader[FAN_PITCHER_G].ToUInt();
+        pitcher._SV   = reader[FAN_PITCHER_SV].ToUInt();
+        pitcher._IP   = static_cast<uint32_t>(reader[FAN_PITCHER_IP].ToFloat());
+        pitcher._H    = reader[FAN_PITCHER_H].ToUInt();
+        pitcher._ER   = reader[FAN_PITCHER_ER].ToUInt();
+        pitcher._HR   = reader[FAN_PITCHER_HR].ToUInt();
+        pitcher._SO   = reader[FAN_PITCHER_SO].ToUInt();
+        pitcher._xBB  = reader[FAN_PITCHER_BB].ToUInt();
         ret.push_back(pitcher);
     }
 
@@ -272,11 +263,10 @@ std::map<QString, std::vector<Apperance>> appearances()
     // Open file
     QFile inputFile(":/data/2019-appearances.csv");
     inputFile.open(QIODevice::ReadOnly);
-    QTextStream textStream(&inputFile);
+    FBBCSVReader reader(inputFile.readAll());
 
-    // Tokenize header data
-    QStringList parsed = textStream.readLine().split(",");
-    parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    // Skip header
+    reader.ReadRow();
 
     enum
     {
@@ -310,17 +300,13 @@ std::map<QString, std::vector<Apperance>> appearances()
     };
 
     // Loop rows
-    while (!textStream.atEnd()) {
-
-        // Tokenize this row
-        QStringList parsed = textStream.readLine().split(",");
-        parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    while (reader.ReadRow()) {
 
-        QString id = parsed[APPEARANCE_PLAYERID];
+        QString id = reader[APPEARANCE_PLAYERID].ToString();
 
         Apperance app;
-        app._POS  = parsed[APPEARANCE_POS];
-        app._INN  = parsed[APPEARANCE_INN].toInt();
+        app._POS  = reader[APPEARANCE_POS].ToString();
+        app._INN  = static_cast<uint32_t>(reader[APPEARANCE_INN].ToFloat());
 
         ret[id].push_back(app);
     }
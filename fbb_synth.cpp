@@ -0,0 +1,358 @@
+#include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBPlayerStore.h"
+#include "FBB/FBBProjectionService.h"
+#include "FBB/FBBSyntheticPool.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+//------------------------------------------------------------------------------
+// CSVWriter
+//------------------------------------------------------------------------------
+// Builds a file in FanGraphs' export format: every field quoted, one row per
+// line. Names never contain quotes so nothing is escaped.
+class CSVWriter
+{
+public:
+
+    void Field(const QByteArray& value)
+    {
+        if (!m_rowStart) {
+            m_data += ',';
+        }
+        m_data += '"';
+        m_data += value;
+        m_data += '"';
+        m_rowStart = false;
+    }
+
+    void Field(const QString& value) { Field(value.toUtf8()); }
+    void Field(const char* value) { Field(QByteArray(value)); }
+    void Field(uint32_t value) { Field(QByteArray::number(value)); }
+    void Field(double value, int precision) { Field(QByteArray::number(value, 'f', precision)); }
+
+    void Row(std::initializer_list<const char*> fields)
+    {
+        for (const char* field : fields) {
+            Field(field);
+        }
+        EndRow();
+    }
+
+    void EndRow()
+    {
+        m_data += '\n';
+        m_rowStart = true;
+    }
+
+    bool Save(const QString& path) const
+    {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        file.write(m_data);
+        return file.commit();
+    }
+
+private:
+    QByteArray m_data;
+    bool m_rowStart = true;
+};
+
+// Team names as the projection exports spell them (free agents are blank)
+static const char* TeamName(FBBTeam team)
+{
+    static const char* const s_names[] =
+    {
+        "",
+        "Angels",
+        "Astros",
+        "Athletics",
+        "Blue Jays",
+        "Braves",
+        "Brewers",
+        "Cardinals",
+        "Cubs",
+        "Diamondbacks",
+        "Dodgers",
+        "Giants",
+        "Indians",
+        "Mariners",
+        "Marlins",
+        "Mets",
+        "Nationals",
+        "Orioles",
+        "Padres",
+        "Phillies",
+        "Pirates",
+        "Rangers",
+        "Rays",
+        "Red Sox",
+        "Reds",
+        "Rockies",
+        "Royals",
+        "Tigers",
+        "Twins",
+        "White Sox",
+        "Yankees",
+        "",
+    };
+    static_assert(sizeof(s_names) / sizeof(s_names[0]) == size_t(FBBTeam::FA) + 1, "Team names out of date");
+    return s_names[size_t(team)];
+}
+
+// Positions as the appearances export spells them
+static const char* const s_positions[FBBPlayer::Fielding_Count] = { "C", "1B", "2B", "SS", "3B", "LF", "CF", "RF" };
+
+static double Ratio(double numerator, double denominator)
+{
+    return denominator > 0 ? numerator / denominator : 0.0;
+}
+
+static bool WriteHitters(FBBPlayerStore& store, const QString& path)
+{
+    CSVWriter csv;
+    csv.Row({ "Name", "Team", "G", "PA", "AB", "H", "2B", "3B", "HR", "R", "RBI", "BB", "SO", "HBP", "SB", "CS", "AVG", "OBP", "SLG", "OPS", "wOBA", "Fld", "BsR", "WAR", "ADP", "playerid" });
+
+    for (uint32_t row = 0; row < store.Count(FBBPlayer::PLAYER_TYPE_HITTER); row++) {
+        const FBBPlayer* pPlayer = store.Player(FBBPlayer::PLAYER_TYPE_HITTER, row);
+        const uint32_t PA = pPlayer->Hitting(FBBPlayer::HITTING_STAT_PA);
+        const uint32_t AB = pPlayer->Hitting(FBBPlayer::HITTING_STAT_AB);
+        const uint32_t H = pPlayer->Hitting(FBBPlayer::HITTING_STAT_H);
+        const uint32_t _2B = pPlayer->Hitting(FBBPlayer::HITTING_STAT_2B);
+        const uint32_t _3B = pPlayer->Hitting(FBBPlayer::HITTING_STAT_3B);
+        const uint32_t HR = pPlayer->Hitting(FBBPlayer::HITTING_STAT_HR);
+        const uint32_t BB = pPlayer->Hitting(FBBPlayer::HITTING_STAT_BB);
+        const uint32_t HBP = pPlayer->Hitting(FBBPlayer::HITTING_STAT_HBP);
+        const uint32_t _1B = H > _2B + _3B + HR ? H - _2B - _3B - HR : 0;
+
+        const double OBP = Ratio(H + BB + HBP, AB + BB + HBP);
+        const double SLG = Ratio(_1B + 2 * _2B + 3 * _3B + 4 * HR, AB);
+        const double wOBA = Ratio(0.69 * BB + 0.72 * HBP + 0.88 * _1B + 1.25 * _2B + 1.58 * _3B + 2.03 * HR, AB + BB + HBP);
+
+        csv.Field(pPlayer->Name());
+        csv.Field(TeamName(pPlayer->Team()));
+        csv.Field(uint32_t(PA / 4.1 + 0.5));
+        csv.Field(PA);
+        csv.Field(AB);
+        csv.Field(H);
+        csv.Field(_2B);
+        csv.Field(_3B);
+        csv.Field(HR);
+        csv.Field(pPlayer->Hitting(FBBPlayer::HITTING_STAT_R));
+        csv.Field(pPlayer->Hitting(FBBPlayer::HITTING_STAT_RBI));
+        csv.Field(BB);
+        csv.Field(pPlayer->Hitting(FBBPlayer::HITTING_STAT_SO));
+        csv.Field(HBP);
+        csv.Field(pPlayer->Hitting(FBBPlayer::HITTING_STAT_SB));
+        csv.Field(pPlayer->Hitting(FBBPlayer::HITTING_STAT_CS));
+        csv.Field(Ratio(H, AB), 3);
+        csv.Field(OBP, 3);
+        csv.Field(SLG, 3);
+        csv.Field(OBP + SLG, 3);
+        csv.Field(wOBA, 3);
+        csv.Field("0.0");
+        csv.Field("0.0");
+        csv.Field("0.0");
+        csv.Field("999.0");
+        csv.Field(pPlayer->Id());
+        csv.EndRow();
+    }
+
+    return csv.Save(path);
+}
+
+static bool WritePitchers(FBBPlayerStore& store, const QString& path)
+{
+    CSVWriter csv;
+    csv.Row({ "Name", "Team", "W", "L", "SV", "HLD", "ERA", "GS", "G", "IP", "H", "ER", "HR", "SO", "BB", "WHIP", "K/9", "BB/9", "FIP", "WAR", "ADP", "playerid" });
+
+    for (uint32_t row = 0; row < store.Count(FBBPlayer::PLAYER_TYPE_PITCHER); row++) {
+        const FBBPlayer* pPlayer = store.Player(FBBPlayer::PLAYER_TYPE_PITCHER, row);
+        const uint32_t IP = pPlayer->Pitching(FBBPlayer::PITCHING_STAT_IP);
+        const uint32_t H = pPlayer->Pitching(FBBPlayer::PITCHING_STAT_H);
+        const uint32_t ER = pPlayer->Pitching(FBBPlayer::PITCHING_STAT_ER);
+        const uint32_t HR = pPlayer->Pitching(FBBPlayer::PITCHING_STAT_HR);
+        const uint32_t SO = pPlayer->Pitching(FBBPlayer::PITCHING_STAT_SO);
+        const uint32_t BB = pPlayer->Pitching(FBBPlayer::PITCHING_STAT_BB);
+
+        csv.Field(pPlayer->Name());
+        csv.Field(TeamName(pPlayer->Team()));
+        csv.Field(pPlayer->Pitching(FBBPlayer::PITCHING_STAT_W));
+        csv.Field(pPlayer->Pitching(FBBPlayer::PITCHING_STAT_L));
+        csv.Field(pPlayer->Pitching(FBBPlayer::PITCHING_STAT_SV));
+        csv.Field(pPlayer->Pitching(FBBPlayer::PITCHING_STAT_HLD));
+        csv.Field(9 * Ratio(ER, IP), 2);
+        csv.Field(pPlayer->Pitching(FBBPlayer::PITCHING_STAT_GS));
+        csv.Field(pPlayer->Pitching(FBBPlayer::PITCHING_STAT_G));
+        csv.Field(double(IP), 1);
+        csv.Field(H);
+        csv.Field(ER);
+        csv.Field(HR);
+        csv.Field(SO);
+        csv.Field(BB);
+        csv.Field(Ratio(H + BB, IP), 2);
+        csv.Field(9 * Ratio(SO, IP), 2);
+        csv.Field(9 * Ratio(BB, IP), 2);
+        csv.Field(IP ? Ratio(13.0 * HR + 3.0 * BB - 2.0 * SO, IP) + 3.1 : 0.0, 2);
+        csv.Field("0.0");
+        csv.Field("999.0");
+        csv.Field(pPlayer->Id());
+        csv.EndRow();
+    }
+
+    return csv.Save(path);
+}
+
+static bool WriteAppearances(FBBPlayerStore& store, const QString& path)
+{
+    // Only the name, team, position, innings and id are filled in
+    const int NUM_DEFENSE_FIELDS = 22;
+
+    CSVWriter csv;
+    csv.Row({ "Name", "Team", "Pos", "Inn", "rSZ", "rCERA", "rSB", "rGDP", "rARM", "rGFP", "rPM", "rTS", "DRS", "BIZ", "Plays", "RZR", "OOZ", "FSR", "FRM", "ARM", "DPR", "RngR", "ErrR", "UZR", "UZR/150", "Def", "playerid" });
+
+    for (uint32_t row = 0; row < store.Count(FBBPlayer::PLAYER_TYPE_HITTER); row++) {
+        const FBBPlayer* pPlayer = store.Player(FBBPlayer::PLAYER_TYPE_HITTER, row);
+        for (size_t position = 0; position < FBBPlayer::Fielding_Count; position++) {
+            const float innings = pPlayer->Appearances(FBBPlayer::Fielding(position));
+            if (innings <= 0.f) {
+                continue;
+            }
+            csv.Field(pPlayer->Name());
+            csv.Field(pPlayer->Team() == FBBTeam::FA ? QString() : FBBTeamToString(pPlayer->Team()));
+            csv.Field(s_positions[position]);
+            csv.Field(double(innings), 1);
+            for (int i = 0; i < NUM_DEFENSE_FIELDS; i++) {
+                csv.Field("");
+            }
+            csv.Field(pPlayer->Id());
+            csv.EndRow();
+        }
+    }
+
+    return csv.Save(path);
+}
+
+// Parses "C=13,1B=11,...,DH=4" over the default mix
+static bool ParsePositionMix(const QString& text, FBBSyntheticPool::Options& options)
+{
+    for (const QString& entry : text.split(',', QString::SkipEmptyParts)) {
+        const QStringList pair = entry.split('=');
+        bool ok = false;
+        const float weight = pair.size() == 2 ? pair[1].toFloat(&ok) : 0.f;
+        if (!ok || weight < 0.f) {
+            return false;
+        }
+
+        const QString position = pair[0].trimmed().toUpper();
+        if (position == "DH") {
+            options.dhMix = weight;
+            continue;
+        }
+        auto itr = std::find_if(std::begin(s_positions), std::end(s_positions), [&](const char* name) {
+            return position == name;
+        });
+        if (itr == std::end(s_positions)) {
+            return false;
+        }
+        options.positionMix[itr - std::begin(s_positions)] = weight;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Writes a synthetic player pool and league in the formats the application loads.");
+    parser.addHelpOption();
+    const QCommandLineOption outOption("out", "Output directory.", "dir", "synthetic");
+    const QCommandLineOption hittersOption("hitters", "Number of hitters.", "count", "6000");
+    const QCommandLineOption pitchersOption("pitchers", "Number of pitchers.", "count", "7500");
+    const QCommandLineOption seedOption("seed", "Seed of the pool.", "seed", "2019");
+    const QCommandLineOption positionsOption("positions", "Primary position weights, e.g. C=13,1B=11,DH=4.", "mix");
+    const QCommandLineOption secondaryOption("secondary", "Share of hitters with a second position.", "share", "0.25");
+    const QCommandLineOption startersOption("starters", "Share of pitchers who start.", "share", "0.45");
+    const QCommandLineOption ownersOption("owners", "Number of owners in the league.", "count", "12");
+    const QCommandLineOption budgetOption("budget", "Auction budget per owner.", "dollars", "260");
+    const QCommandLineOption benchOption("bench", "Bench slots per owner.", "count", "3");
+    parser.addOption(outOption);
+    parser.addOption(hittersOption);
+    parser.addOption(pitchersOption);
+    parser.addOption(seedOption);
+    parser.addOption(positionsOption);
+    parser.addOption(secondaryOption);
+    parser.addOption(startersOption);
+    parser.addOption(ownersOption);
+    parser.addOption(budgetOption);
+    parser.addOption(benchOption);
+    parser.process(app);
+
+    FBBSyntheticPool::Options options;
+    options.numHitters = parser.value(hittersOption).toUInt();
+    options.numPitchers = parser.value(pitchersOption).toUInt();
+    options.seed = parser.value(seedOption).toULongLong();
+    options.secondaryShare = parser.value(secondaryOption).toFloat();
+    options.starterShare = parser.value(startersOption).toFloat();
+    if (parser.isSet(positionsOption) && !ParsePositionMix(parser.value(positionsOption), options)) {
+        std::fprintf(stderr, "Invalid position mix: %s\n", qPrintable(parser.value(positionsOption)));
+        return 1;
+    }
+
+    const QDir outDir(parser.value(outOption));
+    if (!outDir.mkpath(".")) {
+        std::fprintf(stderr, "Can't create %s\n", qPrintable(outDir.path()));
+        return 1;
+    }
+
+    FBBPlayerStore store;
+    FBBSyntheticPool::Generate(store, options);
+
+    // League with numbered owners. Ids are fixed so saved drafts line up
+    // across runs.
+    FBBLeaugeSettings settings(&app);
+    settings.leauge.budget = parser.value(budgetOption).toUInt();
+    settings.positions.numBench = parser.value(benchOption).toUInt();
+    settings.owners.clear();
+    const uint32_t numOwners = std::max(1u, parser.value(ownersOption).toUInt());
+    for (uint32_t i = 0; i < numOwners; i++) {
+        FBBLeaugeSettings::Owner owner{ QString("Owner #%1").arg(i + 1), QString("O%1").arg(i + 1, 2, 10, QChar('0')) };
+        settings.owners[100 + i] = std::make_shared<FBBLeaugeSettings::Owner>(owner);
+    }
+
+    const std::pair<QString, bool> results[] =
+    {
+        { FBBProjectionService::HITTING_FILE_NAME, WriteHitters(store, outDir.filePath(FBBProjectionService::HITTING_FILE_NAME)) },
+        { FBBProjectionService::PITCHING_FILE_NAME, WritePitchers(store, outDir.filePath(FBBProjectionService::PITCHING_FILE_NAME)) },
+        { FBBProjectionService::APPEARANCE_FILE_NAME, WriteAppearances(store, outDir.filePath(FBBProjectionService::APPEARANCE_FILE_NAME)) },
+    };
+
+    int ret = 0;
+    for (const auto& result : results) {
+        if (!result.second) {
+            std::fprintf(stderr, "Can't write %s\n", qPrintable(outDir.filePath(result.first)));
+            ret = 1;
+        }
+    }
+
+    QSaveFile leaugeFile(outDir.filePath(FBBLeaugeSettings::FILE_NAME));
+    if (!leaugeFile.open(QIODevice::WriteOnly) || leaugeFile.write(QJsonDocument(settings.ToJson()).toJson()) < 0 || !leaugeFile.commit()) {
+        std::fprintf(stderr, "Can't write %s\n", qPrintable(leaugeFile.fileName()));
+        ret = 1;
+    }
+
+    if (ret == 0) {
+        std::printf("Wrote %u hitters, %u pitchers and %u owners to %s\n", options.numHitters, options.numPitchers, numOwners, qPrintable(outDir.path()));
+    }
+    return ret;
+}
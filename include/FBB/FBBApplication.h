@@ -25,6 +25,11 @@ public:
     void Save();
     void SaveAs();
     void Load(const QString& file);
+    bool ExportCSV(const QString& file);
+
+    // Projections and league (if there's one) from a directory written by
+    // fbb_synth, taking effect on the next projection load
+    void LoadDataDirectory(const QString& directory);
 
     // Singleton
     static FBBApplication* Instance() { return s_instance; }
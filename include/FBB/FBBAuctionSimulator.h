@@ -0,0 +1,113 @@
+#pragma once
+
+#include "FBB/FBBPlayer.h"
+#include "FBB/FBBSimulationRunner.h"
+
+#include <QObject>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// FBBAuctionSimulator
+//------------------------------------------------------------------------------
+// Plays out the rest of the auction many times from a snapshot of the draft.
+// Players are nominated roughly best first; every owner with room bids up to
+// the player's value scaled by their own aggression and some noise, and the
+// winner pays one more than the runner up (or what they can afford).
+//
+// Simulations run on an FBBSimulationRunner, so the results only depend on
+// the seed and count. Workers fold their tallies into the shared results after
+// each batch and Progress is emitted (throttled) so the board can update while
+// it runs.
+class FBBAuctionSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    struct Player
+    {
+        FBBPlayer::PlayerType type;
+
+        // Dollar value going into the auction (at least $1)
+        float value;
+    };
+
+    struct Owner
+    {
+        // Money left
+        int32_t budget;
+
+        // Open slots; bench slots take either type
+        uint32_t hitters;
+        uint32_t pitchers;
+        uint32_t bench;
+
+        // Paid over value so far (1 is neutral)
+        float aggression;
+    };
+
+    struct State
+    {
+        std::vector<Player> vecPlayers;
+        std::vector<Owner> vecOwners;
+    };
+
+    // Price distribution of one player over the simulations they were sold in
+    struct Result
+    {
+        float meanPrice;
+        float lowPrice;
+        float medianPrice;
+        float highPrice;
+
+        // Chance of still being unsold after every owner nominates once more
+        float available;
+    };
+
+    FBBAuctionSimulator(QObject* parent = nullptr);
+    ~FBBAuctionSimulator();
+
+    // Cancels any running simulation and starts numSimulations new ones
+    void Start(const State& state, uint32_t numSimulations, uint64_t seed);
+
+    // Stops the workers (returns without waiting for them)
+    void Cancel();
+
+    // Results so far (indexed like State::vecPlayers)
+    std::vector<Result> Results() const;
+    uint32_t Completed() const { return m_runner.Completed(); }
+    uint32_t Total() const { return m_runner.Total(); }
+
+signals:
+    void Progress(uint32_t completed, uint32_t total);
+
+private:
+
+    // Tallies of a batch of simulations
+    struct Tally
+    {
+        // Price histogram per player ($0 to the budget cap)
+        std::vector<uint32_t> vecPrices;
+        std::vector<uint32_t> vecSoldSoon;
+        uint32_t simulations = 0;
+
+        void Reset(size_t numPlayers, size_t numPrices);
+        void Merge(const Tally& tally);
+    };
+
+    class Worker;
+
+    void Simulate(std::mt19937_64& rng, Tally& tally, std::vector<Owner>& vecOwners, std::vector<uint32_t>& vecOrder, std::vector<float>& vecNomination) const;
+
+    FBBSimulationRunner m_runner;
+
+    // Immutable while the workers run
+    State m_state;
+    size_t m_numPrices = 0;
+
+    // Guarded by the runner's mutex
+    Tally m_tally;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+//------------------------------------------------------------------------------
+// FBBCSVField
+//------------------------------------------------------------------------------
+// Non-owning view of a single CSV cell. The view points into the reader's
+// buffer and is only valid until the next call to FBBCSVReader::ReadRow().
+class FBBCSVField
+{
+public:
+
+    FBBCSVField() = default;
+    FBBCSVField(const char* pData, uint32_t size)
+        : m_pData(pData)
+        , m_size(size)
+    {
+    }
+
+    const char* Data() const { return m_pData; }
+    uint32_t Size() const { return m_size; }
+    bool IsEmpty() const { return m_size == 0; }
+
+    // Conversions (malformed numbers return 0, same as QString::toUInt/toFloat)
+    QString ToString() const;
+    uint32_t ToUInt() const;
+    float ToFloat() const;
+
+    // Lexicographic compare against a null terminated string
+    int Compare(const char* str) const;
+    bool operator==(const char* str) const { return Compare(str) == 0; }
+    bool operator!=(const char* str) const { return Compare(str) != 0; }
+
+private:
+    const char* m_pData = nullptr;
+    uint32_t m_size = 0;
+};
+
+//------------------------------------------------------------------------------
+// FBBCSVReader
+//------------------------------------------------------------------------------
+// RFC-4180 tokenizer. Structural characters (quotes, commas and newlines) are
+// found 16 bytes at a time with SSE2 where available. Quoted cells may contain
+// commas, newlines and escaped ("") quotes.
+class FBBCSVReader
+{
+public:
+
+    // Takes a (shallow) copy of the buffer and keeps it alive
+    explicit FBBCSVReader(const QByteArray& data);
+
+    // Reads [pBegin, pEnd) which must outlive the reader
+    FBBCSVReader(const char* pBegin, const char* pEnd);
+
+    // Advance to the next non-blank row. Returns false at the end of input.
+    bool ReadRow();
+
+    // Fields of the current row (out of range indices return an empty field)
+    size_t FieldCount() const { return m_fields.size(); }
+    const FBBCSVField& operator[](size_t index) const;
+
+    // Start of the next unread row
+    const char* Position() const { return m_pCursor; }
+
+    // Split [pBegin, pEnd) into at most `count` ranges that each start on a row
+    // boundary. Newlines inside quoted cells are not treated as boundaries.
+    using Range = std::pair<const char*, const char*>;
+    static std::vector<Range> SplitRows(const char* pBegin, const char* pEnd, size_t count);
+
+private:
+
+    const char* FindStructural(const char* p);
+
+    QByteArray m_data;
+    const char* m_pBegin = nullptr;
+    const char* m_pCursor = nullptr;
+    const char* m_pEnd = nullptr;
+
+    // Cached structural bitmask of the current 16 byte block
+    size_t m_blockOffset = 0;
+    uint32_t m_blockMask = 0;
+    bool m_blockValid = false;
+
+    // Current row
+    std::vector<FBBCSVField> m_fields;
+
+    // Unescaped copies of cells containing "" (field index, scratch offset)
+    std::vector<char> m_scratch;
+    std::vector<std::pair<size_t, size_t>> m_escaped;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "FBB/FBBPlayer.h"
+#include "FBB/FBBLeaugeSettings.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// FBBCategory
+//------------------------------------------------------------------------------
+// Describes how a scoring category is derived from the projection columns.
+// Counting categories score the numerator directly. Rate categories score a
+// player's contribution to the pooled rate (numerator - rate * denominator) so
+// the rate is weighted by playing time.
+struct FBBCategory
+{
+    using Extractor = float (*)(const FBBPlayerColumns& columns, uint32_t row);
+    using Enabled = bool (*)(const FBBLeaugeSettings::Categories& categories);
+
+    const char* name;
+    FBBPlayer::PlayerType type;
+
+    // Column in FBBPlayerColumns::z (a HittingCategory or PitchingCategory)
+    uint32_t index;
+
+    Extractor numerator;
+    Extractor denominator;
+
+    // -1 if lower is better
+    float sign;
+
+    // Default standings gain points denominator: how much of the category (or
+    // of the team rate) one place in the standings takes in a 12 team league
+    float sgp;
+
+    Enabled isEnabled;
+
+    bool IsRate() const { return denominator != nullptr; }
+};
+
+// Every category of a player type (indexed by z column)
+const std::vector<FBBCategory>& FBBCategories(FBBPlayer::PlayerType type);
+
+// Categories turned on in the league settings
+std::vector<const FBBCategory*> FBBEnabledCategories(FBBPlayer::PlayerType type, const FBBLeaugeSettings::Categories& categories);
+
+// Scores the categories over vecRows and stores their sum in zScore. The z
+// columns of every other category are cleared.
+void FBBCalculateZScores(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<uint32_t>& vecRows);
+
+// Same, but the category means and deviations only come from vecPool (a
+// subset of vecRows)
+void FBBCalculateZScores(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool);
+
+// Scores the categories in standings gain points instead, given a denominator
+// per category (parallel to vecCategories) and the players on a team. Rate
+// categories are measured against a team of average players from vecPool.
+void FBBCalculateSGP(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<float>& vecDenominators, size_t teamSize, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool);
@@ -4,7 +4,16 @@
 #include <QFont>
 #include <QJsonObject>
 
+#include "FBB/FBBInflation.h"
 #include "FBB/FBBPlayer.h"
+#include "FBB/FBBRenderCache.h"
+#include "FBB/FBBValuation.h"
+#include "FBB/FBBWhatIf.h"
+
+#include <memory>
+
+class FBBAuctionSimulator;
+class FBBPlayerStore;
 
 class FBBDraftBoardModel : public QAbstractTableModel
 {
@@ -81,6 +90,9 @@ public:
         // Fantasy
         COLUMN_Z,
         COLUMN_ESTIMATE,
+        COLUMN_INFLATED,
+        COLUMN_MARKET,
+        COLUMN_AVAILABLE,
 
         // Comment
         COLUMN_COMMENT,
@@ -95,17 +107,69 @@ public:
         PrintFormatRole = Qt::UserRole + 2,
     };
 
+    // How a column reads, shows and lays out its values. data(), headerData(),
+    // sorting, the CSV export and the board's column widths all go through
+    // the one table of these (see ColumnInfo).
+    struct Column
+    {
+        // Players the column has values for
+        enum Applies
+        {
+            APPLIES_ALL,
+            APPLIES_HITTERS,
+            APPLIES_PITCHERS,
+        };
+
+        const char* header;
+        Applies applies;
+
+        // Typed value, the one sorted and exported
+        QVariant (*value)(const FBBDraftBoardModel& model, const FBBPlayer& player);
+
+        // Display text of a value (null shows the value as is)
+        QVariant (*format)(const QVariant& value);
+
+        // Tooltip (null repeats the display text)
+        QVariant (*toolTip)(const FBBDraftBoardModel& model, const FBBPlayer& player);
+
+        int alignment;
+
+        // Fixed width in average characters (0 stretches)
+        int width;
+    };
+
+    static const Column& ColumnInfo(int column);
+
     FBBDraftBoardModel(QObject* parent = nullptr);
 
-    void Reset(const std::vector<FBBPlayer*>& vecPlayers);
+    void Reset(FBBPlayerStore* pStore);
     uint32_t PlayerCount() const;
     void AddPlayer(FBBPlayer* pPlayer);
     FBBPlayer* GetPlayer(uint32_t index);
+
+    // Typed value of a column (invalid where it doesn't apply to the player)
+    QVariant ColumnValue(const FBBPlayer* pPlayer, int column) const;
+
+    // Position of every row in the column's ascending order (equal values
+    // share one). Built on first use and kept until the column changes.
+    const std::vector<uint32_t>& SortRanks(int column) const;
     std::vector<FBBPlayer*> GetValidHitters();
     std::vector<FBBPlayer*> GetValidPitchers();
+
+    // Assigns a player to an owner and reprices the remaining pool
+    void DraftPlayer(FBBPlayer* pPlayer, FBBOwnerId owner, uint32_t paid);
+
+    // Rescores and reprices every player (e.g. after the settings change)
+    void Recalculate();
+
+    // Evaluates hypothetical purchases against the current draft in parallel.
+    // The snapshot they share is taken on the first call after a pick.
+    std::vector<FBBWhatIf::Result> WhatIf(const std::vector<FBBWhatIf::Purchase>& vecPurchases);
     
     // Export
     QJsonObject ToJson() const;
+    void FromJson(const QJsonObject& json);
+    QByteArray ToCSV() const;
 
     // QAbstractTableModel
     virtual int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -117,13 +181,61 @@ public:
 signals:
     void PlayerDrafted(FBBPlayer* player);
 
+    // A saved draft was applied (once, after the board is repriced)
+    void DraftLoaded();
+
 private:
 
-    void CalculateZScores();
-    void CalculateHittingZScores();
-    void CalculatePitchingZScores();
+    static const Column s_columns[];
+
+    // Uncached data() of the display, tooltip and raw data roles
+    QVariant CellData(const FBBPlayer* pPlayer, int column, int role) const;
 
+    void CalculateZScores();
+    void CalculateZScores(FBBPlayer::PlayerType type);
+    void Score(FBBPlayer::PlayerType type, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool);
+    void ScoreDraftablePool(FBBPlayer::PlayerType type, const std::vector<uint32_t>& vecRows);
+    void ResetValuation(FBBPlayer::PlayerType type, const std::vector<uint32_t>& vecRows);
+    std::vector<uint32_t> GetValidRows(FBBPlayer::PlayerType type) const;
+    FBBValuation& Valuation(FBBPlayer::PlayerType type);
+    std::vector<uint32_t>& DraftablePool(FBBPlayer::PlayerType type);
+    int ModelRow(const FBBPlayer* pPlayer) const;
+
+    // Restarts the inflation tracker from the current picks. Rebasing takes
+    // the current estimates as the pre-draft values first; mid-draft those
+    // already price in the money spent, so inflation starts back near 1.
+    void ResetInflation(bool rebase);
+
+    // Restarts the auction simulation from the current draft
+    void Simulate();
+    void OnSimulationProgress();
+
+    FBBPlayerStore* m_pStore = nullptr;
     std::vector<FBBPlayer*> m_vecPlayers;
+    FBBValuation m_hittingValuation;
+    FBBValuation m_pitchingValuation;
+
+    // Last draftable pools (sorted rows), the starting guess for the next
+    // valuation
+    std::vector<uint32_t> m_vecHittingPool;
+    std::vector<uint32_t> m_vecPitchingPool;
+
+    // Money spent against the pre-draft value of the players bought
+    FBBInflation m_inflation;
+
+    // Draft snapshot for what-if queries (null once stale)
+    std::shared_ptr<const FBBWhatIf::Snapshot> m_spWhatIf;
+
+    // Undrafted players in the running simulation (indexed like its results)
+    FBBAuctionSimulator* m_pSimulator = nullptr;
+    std::vector<FBBPlayer*> m_vecSimulated;
+
+    // Display strings and tooltips of the cells painted so far. Whatever
+    // changes the board emits dataChanged (or resets), which invalidates them.
+    mutable FBBRenderCache m_renderCache;
+
+    // SortRanks by column (empty when stale)
+    mutable std::vector<std::vector<uint32_t>> m_vecSortRanks;
 
     QFont m_font;
     QFont m_draftedFont;
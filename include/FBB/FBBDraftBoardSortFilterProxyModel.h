@@ -15,12 +15,16 @@ public:
     void SetShowDrafted(bool enable);
     void SetPositionFilter(FBBPositionMask mask);
 
+    virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
     virtual bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
     virtual bool filterAcceptsColumn(int sourceColumn, const QModelIndex& sourceParent) const override;
     virtual bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
 
 private:
 
+    // Runs every row back through filterAcceptsRow
+    void Refilter();
+
     bool m_onlyHitters = false;
     bool m_onlyPitchers = false;
     bool m_showDrafted = false;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+// FBBInflation
+//------------------------------------------------------------------------------
+// Tracks auction inflation: the money left in the league over the pre-draft
+// value of the players still to be bought. Owners paying over value make the
+// rest of the pool cheaper and vice versa. Only running totals are kept, so a
+// pick (or undoing one) is O(1).
+class FBBInflation
+{
+public:
+
+    // Starts over with the league's money and the pre-draft value of every
+    // player expected to be bought (values below $0 count as $0)
+    void Reset(double totalMoney, double totalValue);
+
+    // Records a pick of a player worth value before the draft
+    void Draft(float value, uint32_t paid);
+    void Undraft(float value, uint32_t paid);
+
+    double Spent() const { return m_spent; }
+    double ValueBought() const { return m_valueBought; }
+
+    // Remaining money per remaining pre-draft dollar (1 is no inflation)
+    float Factor() const { return m_factor; }
+
+private:
+
+    void Update();
+
+    double m_totalMoney = 0;
+    double m_totalValue = 0;
+    double m_spent = 0;
+    double m_valueBought = 0;
+    float m_factor = 1.f;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QJsonObject>
 #include <QString>
 #include <QMap>
 #include <QTime>
@@ -128,7 +129,31 @@ public:
             ATC,
         };
         
+        // Where the replacement level is drawn
+        enum class Replacement
+        {
+            Overall,
+            Position,
+        };
+
+        // How players are scored before they are priced
+        enum class Engine
+        {
+            ZScore,
+            SGP,
+        };
+
+        // Players the category means and deviations are taken over
+        enum class Pool
+        {
+            Valid,
+            Draftable,
+        };
+
         Source source = Source::Steamer;
+        Engine engine = Engine::ZScore;
+        Replacement replacement = Replacement::Overall;
+        Pool pool = Pool::Valid;
         float hittingPitchingSplit = 0.70f;
         uint32_t minAB = 50;
         uint32_t minIP = 10;
@@ -136,6 +161,15 @@ public:
 
     } projections;
 
+    // Standings gain points denominators by category name. Categories without
+    // one use the default from their FBBCategory.
+    struct SGP
+    {
+        QMap<QString, float> hitting;
+        QMap<QString, float> pitching;
+
+    } sgp;
+
     std::shared_ptr<Owner> CreateOwner(const Owner& owner = Owner{})
     {
         FBBOwnerId ownerId = owners.empty() ? 100 : owners.rbegin()->first + QTime::currentTime().msecsSinceStartOfDay();
@@ -233,6 +267,14 @@ public:
         return SumHitters() + SumPitchers() + positions.numBench;
     }
     
+    // League, categories, roster positions and owners (projection options
+    // and SGP denominators aren't saved). Fields missing from the JSON keep
+    // their current values. FILE_NAME is what a league is saved as next
+    // to its projections.
+    static const char* const FILE_NAME;
+    QJsonObject ToJson() const;
+    void FromJson(const QJsonObject& json);
+
     void OnAccept() const
     {
         emit SettingsChanged(*this);
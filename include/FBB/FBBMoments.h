@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+// FBBMoments
+//------------------------------------------------------------------------------
+// Means and (co)variances of a column of counting stats (x) or of a rate
+// stat's numerator (x) and denominator (y). FromColumns summarizes a block of
+// rows in two passes: one sums for the means and a second sums deviations
+// from them. Neither pass carries a dependency on a running mean, so the loops
+// stay branch free and vectorize. Blocks summarized on separate threads
+// combine with Merge (Chan et al.) into the moments of the whole column.
+class FBBMoments
+{
+public:
+
+    // Moments of n samples of x (and y if pY isn't null). A weight of 0 leaves
+    // a sample out and 1 counts it; a null pWeight counts every sample.
+    static FBBMoments FromColumns(const float* pX, const float* pY, const float* pWeight, size_t n)
+    {
+        if (pY) {
+            return pWeight ? TwoPass<true, true>(pX, pY, pWeight, n) : TwoPass<true, false>(pX, pY, pWeight, n);
+        }
+        return pWeight ? TwoPass<false, true>(pX, pY, pWeight, n) : TwoPass<false, false>(pX, pY, pWeight, n);
+    }
+
+    void Merge(const FBBMoments& other)
+    {
+        if (other.m_count == 0) {
+            return;
+        }
+        if (m_count == 0) {
+            *this = other;
+            return;
+        }
+
+        const double count = double(m_count + other.m_count);
+        const double weight = double(m_count) * double(other.m_count) / count;
+        const double dx = other.m_meanX - m_meanX;
+        const double dy = other.m_meanY - m_meanY;
+
+        m_meanX += dx * other.m_count / count;
+        m_meanY += dy * other.m_count / count;
+        m_m2X += other.m_m2X + dx * dx * weight;
+        m_m2Y += other.m_m2Y + dy * dy * weight;
+        m_cXY += other.m_cXY + dx * dy * weight;
+        m_count += other.m_count;
+    }
+
+    uint64_t Count() const { return m_count; }
+    double MeanX() const { return m_meanX; }
+    double MeanY() const { return m_meanY; }
+
+    // Population (co)variances
+    double VarianceX() const { return m_count ? m_m2X / m_count : 0; }
+    double VarianceY() const { return m_count ? m_m2Y / m_count : 0; }
+    double CovarianceXY() const { return m_count ? m_cXY / m_count : 0; }
+
+private:
+
+    // Independent accumulators per pass. Floating point sums can't be
+    // reordered by the compiler, so the lanes are spelled out for it to
+    // vectorize instead.
+    static const size_t LANES = 4;
+
+    static double Total(const double* pLanes)
+    {
+        double total = 0;
+        for (size_t l = 0; l < LANES; l++) {
+            total += pLanes[l];
+        }
+        return total;
+    }
+
+    template <bool HAS_Y, bool HAS_WEIGHT>
+    static FBBMoments TwoPass(const float* pX, const float* pY, const float* pWeight, size_t n)
+    {
+        const size_t body = n - n % LANES;
+
+        double count[LANES] = {};
+        double sumX[LANES] = {};
+        double sumY[LANES] = {};
+        auto Sum = [&](size_t i, size_t l) {
+            const double w = HAS_WEIGHT ? pWeight[i] : 1.0;
+            count[l] += w;
+            sumX[l] += w * pX[i];
+            if (HAS_Y) {
+                sumY[l] += w * pY[i];
+            }
+        };
+        for (size_t i = 0; i < body; i += LANES) {
+            for (size_t l = 0; l < LANES; l++) {
+                Sum(i + l, l);
+            }
+        }
+        for (size_t i = body; i < n; i++) {
+            Sum(i, i - body);
+        }
+
+        FBBMoments ret;
+        const double total = Total(count);
+        if (total == 0) {
+            return ret;
+        }
+        ret.m_count = uint64_t(total);
+        ret.m_meanX = Total(sumX) / total;
+        ret.m_meanY = Total(sumY) / total;
+
+        double m2X[LANES] = {};
+        double m2Y[LANES] = {};
+        double cXY[LANES] = {};
+        auto Deviate = [&](size_t i, size_t l) {
+            const double w = HAS_WEIGHT ? pWeight[i] : 1.0;
+            const double dx = pX[i] - ret.m_meanX;
+            m2X[l] += w * dx * dx;
+            if (HAS_Y) {
+                const double dy = pY[i] - ret.m_meanY;
+                m2Y[l] += w * dy * dy;
+                cXY[l] += w * dx * dy;
+            }
+        };
+        for (size_t i = 0; i < body; i += LANES) {
+            for (size_t l = 0; l < LANES; l++) {
+                Deviate(i + l, l);
+            }
+        }
+        for (size_t i = body; i < n; i++) {
+            Deviate(i, i - body);
+        }
+        ret.m_m2X = Total(m2X);
+        ret.m_m2Y = Total(m2Y);
+        ret.m_cXY = Total(cXY);
+        return ret;
+    }
+
+    uint64_t m_count = 0;
+    double m_meanX = 0;
+    double m_meanY = 0;
+    double m_m2X = 0;
+    double m_m2Y = 0;
+    double m_cXY = 0;
+};
@@ -6,19 +6,29 @@
 #include "FBB/FBBApplication.h"
 
 #include <QString>
-#include <QObject>
+#include <QChar>
 
 #include <cstdint>
 #include <memory>
 #include <array>
+#include <vector>
 
 using FBBPlayerId = QString;
+using FBBPlayerHandle = uint32_t;
 using FBBOwnerId = uint64_t;
 
-class FBBPlayer : public QObject
-{
-    Q_OBJECT
+// Handle of a player that has not been registered
+static const FBBPlayerHandle FBB_INVALID_PLAYER_HANDLE = UINT32_MAX;
+
+struct FBBPlayerColumns;
 
+//------------------------------------------------------------------------------
+// FBBPlayer
+//------------------------------------------------------------------------------
+// Lightweight view of one row of an FBBPlayerStore. Accessors read and write
+// straight through to the store's columns.
+class FBBPlayer
+{
 public:
 
     enum HittingStats
@@ -53,6 +63,7 @@ public:
         PITCHING_STAT_HR,
         PITCHING_STAT_SO,
         PITCHING_STAT_BB,
+        PITCHING_STAT_HLD,
 
         PitchingStats_Count
     };
@@ -71,163 +82,300 @@ public:
         Fielding_Count
     };
 
+    // Categories with a z-score
+    enum HittingCategory
+    {
+        HITTING_CATEGORY_AVG,
+        HITTING_CATEGORY_HR,
+        HITTING_CATEGORY_R,
+        HITTING_CATEGORY_RBI,
+        HITTING_CATEGORY_SB,
+        HITTING_CATEGORY_OBP,
+        HITTING_CATEGORY_SLG,
+        HITTING_CATEGORY_OPS,
+        HITTING_CATEGORY_H,
+        HITTING_CATEGORY_TB,
+        HITTING_CATEGORY_BB,
+        HITTING_CATEGORY_RBIpR,
+        HITTING_CATEGORY_xBH,
+        HITTING_CATEGORY_SBmCS,
+        HITTING_CATEGORY_wOBA,
+
+        HittingCategory_Count
+    };
+
+    enum PitchingCategory
+    {
+        PITCHING_CATEGORY_W,
+        PITCHING_CATEGORY_SV,
+        PITCHING_CATEGORY_ERA,
+        PITCHING_CATEGORY_WHIP,
+        PITCHING_CATEGORY_SO,
+        PITCHING_CATEGORY_AVG,
+        PITCHING_CATEGORY_Kp9,
+        PITCHING_CATEGORY_KpBB,
+        PITCHING_CATEGORY_FIP,
+        PITCHING_CATEGORY_HLD,
+        PITCHING_CATEGORY_QS,
+
+        PitchingCategory_Count
+    };
+
     enum PlayerType
     {
         PLAYER_TYPE_HITTER,
         PLAYER_TYPE_PITCHER,
     };
 
-    FBBPlayer(PlayerType type, const FBBPlayerId& id, const QString& name,  QObject* pParet)
-        : QObject(pParet)
-        , type(type)
-        , id(id)
-        , name(name)
+    FBBPlayer(FBBPlayerColumns* pColumns, PlayerType type, uint32_t row)
+        : m_pColumns(pColumns)
+        , m_type(type)
+        , m_row(row)
     {
     }
 
-    const PlayerType type;
-    const FBBPlayerId id;
-    const QString name;
-
-    FBBTeam team = FBBTeam::Unknown;
-    uint32_t age = 0;
-    uint32_t experience = 0;
-
-    struct Appearances
-    {
-        Appearances()
-        {
-            memset(this, 0, sizeof(Appearances));
-        }
-
-        struct Fielding
-        {
-            float C;
-            float _1B;
-            float _2B;
-            float SS;
-            float _3B;
-            float LF;
-            float CF;
-            float RF;
-        } fielding;
-
-    } appearances;
-
-    struct Projection
+    // Identity
+    PlayerType Type() const { return m_type; }
+    uint32_t Row() const { return m_row; }
+    FBBPlayerId Id() const;
+    QString Name() const;
+    FBBPlayerHandle& Handle();
+    FBBPlayerHandle Handle() const;
+    FBBTeam& Team();
+    FBBTeam Team() const;
+    uint32_t& Age();
+    uint32_t Age() const;
+    uint32_t& Experience();
+    uint32_t Experience() const;
+
+    // Projection (hitting stats for hitters, pitching stats for pitchers)
+    uint32_t& Hitting(HittingStats stat);
+    uint32_t Hitting(HittingStats stat) const;
+    uint32_t& Pitching(PitchingStats stat);
+    uint32_t Pitching(PitchingStats stat) const;
+    float& Appearances(Fielding position);
+    float Appearances(Fielding position) const;
+
+    float AVG() const
     {
-        struct Hitting
-        {
-            uint32_t PA  = 0;
-            uint32_t AB  = 0;
-            uint32_t H   = 0;
-            uint32_t _2B = 0;
-            uint32_t _3B = 0;
-            uint32_t HR  = 0;
-            uint32_t R   = 0;
-            uint32_t RBI = 0;
-            uint32_t BB  = 0;
-            uint32_t SO  = 0;
-            uint32_t HBP = 0;
-            uint32_t SB  = 0;
-            uint32_t CS  = 0;
-
-            // uint32_t AVG;
-            // uint32_t OBP;
-            // uint32_t SLG;
-            // uint32_t OPS;
-            // uint32_t wOBA;
-            // uint32_t wRC;
-            // uint32_t BsR;
-            // uint32_t Fld;
-            // uint32_t Off;
-            // uint32_t Def;
-            // uint32_t WAR;
-
-            float AVG() const
-            {
-                return AB > 0 ? H / float(AB) : 0.f;
-            }
-
-        } hitting;
-
-        struct Pitching
-        {
-            uint32_t W  = 0;
-            uint32_t L  = 0;
-            uint32_t GS = 0;
-            uint32_t G  = 0;
-            uint32_t SV = 0;
-            uint32_t IP = 0;
-            uint32_t H  = 0;
-            uint32_t ER = 0;
-            uint32_t HR = 0;
-            uint32_t SO = 0;
-            uint32_t BB = 0;
-
-            // uint32_t ERA;
-            // "WHIP"
-            // "K/9"
-            // "BB/9"
-            // "FIP"
-            // "WAR"
-            // "RA9-WAR"
-
-            float ERA() const
-            {
-                return IP > 0 ? (9*ER / float(IP)) : 0.f;
-            }
-
-            float WHIP() const
-            {
-                return IP > 0 ? (BB + H) / float(IP) : 0.f;
-            }
-        } pitching;
-
-    } projection;
-
-
-    struct Calculations
+        const uint32_t AB = Hitting(HITTING_STAT_AB);
+        return AB > 0 ? Hitting(HITTING_STAT_H) / float(AB) : 0.f;
+    }
+
+    float ERA() const
     {
-        struct {
-            float AVG;
-            float RBI;
-            float R;
-            float SB;
-            float HR;
-        } zHitting;
-
-        struct {
-            float W;
-            float SV;
-            float ERA;
-            float WHIP;
-            float SO;
-        } zPitching;
-
-        float zScore = 0;
-        float estimate = 0;
-        uint32_t rank = 0;
-
-    } calculations;
-
-    struct DraftInfo
+        const uint32_t IP = Pitching(PITCHING_STAT_IP);
+        return IP > 0 ? (9 * Pitching(PITCHING_STAT_ER) / float(IP)) : 0.f;
+    }
+
+    float WHIP() const
     {
-        FBBOwnerId owner = 0;
-        uint32_t paid = 0;
-        FBBPositionBits position = FBB_POSITION_UNKNOWN;
-    } draftInfo;
+        const uint32_t IP = Pitching(PITCHING_STAT_IP);
+        return IP > 0 ? (Pitching(PITCHING_STAT_BB) + Pitching(PITCHING_STAT_H)) / float(IP) : 0.f;
+    }
+
+    // Calculations
+    float& ZHitting(HittingCategory category);
+    float ZHitting(HittingCategory category) const;
+    float& ZPitching(PitchingCategory category);
+    float ZPitching(PitchingCategory category) const;
+    float& ZScore();
+    float ZScore() const;
+    float Estimate() const;
+    float FrozenEstimate() const;
+    void FreezeEstimate();
+    float& BaseValue();
+    float BaseValue() const;
+
+    // Simulated auction (see FBBAuctionSimulator)
+    float MarketPrice() const;
+    float MarketLow() const;
+    float MarketHigh() const;
+    float Available() const;
+    uint32_t& Rank();
+    uint32_t Rank() const;
+
+    // Draft info
+    FBBOwnerId& Owner();
+    FBBOwnerId Owner() const;
+    uint32_t& Paid();
+    uint32_t Paid() const;
+    FBBPositionBits& DraftPosition();
+    FBBPositionBits DraftPosition() const;
 
     bool operator<(const FBBPlayer& rhs) const
     {
-        return id < rhs.id;
+        return Handle() < rhs.Handle();
     }
 
     bool operator==(const FBBPlayer& rhs) const
     {
-        return id == rhs.id;
+        return Handle() == rhs.Handle();
     }
 
     FBBPositionMask EligablePositions() const;
     bool IsValidUnderCurrentSettings() const;
+
+private:
+    FBBPlayerColumns* m_pColumns;
+    PlayerType m_type;
+    uint32_t m_row;
 };
+
+//------------------------------------------------------------------------------
+// FBBPlayerColumns
+//------------------------------------------------------------------------------
+// One contiguous array per field for a single partition (hitters or pitchers)
+// of an FBBPlayerStore.
+struct FBBPlayerColumns
+{
+    // Ids and names live in a UTF-16 pool. Player i's id is
+    // [stringOffsets[2i], stringOffsets[2i+1]) and its name runs up to
+    // stringOffsets[2i+2].
+    std::vector<QChar> pool;
+    std::vector<uint32_t> stringOffsets = { 0 };
+
+    // Identity
+    std::vector<FBBPlayerHandle> handle;
+    std::vector<FBBTeam> team;
+    std::vector<uint32_t> age;
+    std::vector<uint32_t> experience;
+
+    // Projection (one column per hitting or pitching stat)
+    std::vector<std::vector<uint32_t>> stats;
+    std::array<std::vector<float>, FBBPlayer::Fielding_Count> fielding;
+
+    // Calculations (one column per hitting or pitching category)
+    std::vector<std::vector<float>> z;
+    std::vector<float> zScore;
+    std::vector<float> estimate;
+    std::vector<uint32_t> rank;
+
+    // Non-zero for players in the valuation pool (valid under the settings)
+    std::vector<uint8_t> pooled;
+
+    // Positional scarcity bonus on top of zScore when valuing by position
+    std::vector<float> scarcity;
+
+    // Simulated prices and chance of going unsold in the next lap of
+    // nominations (see FBBAuctionSimulator)
+    std::vector<float> marketPrice;
+    std::vector<float> marketLow;
+    std::vector<float> marketHigh;
+    std::vector<float> available;
+
+    // Dollar values before the draft, inflated as it goes (see FBBInflation)
+    std::vector<float> baseValue;
+
+    // Current auction prices of undrafted players (see FBBValuation)
+    float replacementZ = 0.f;
+    float costPerZ = 0.f;
+
+    // Draft info
+    std::vector<FBBOwnerId> owner;
+    std::vector<uint32_t> paid;
+    std::vector<FBBPositionBits> position;
+
+    uint32_t Count() const { return static_cast<uint32_t>(handle.size()); }
+};
+
+inline FBBPlayerId FBBPlayer::Id() const
+{
+    const uint32_t* pOffsets = m_pColumns->stringOffsets.data() + 2 * m_row;
+    return QString(m_pColumns->pool.data() + pOffsets[0], int(pOffsets[1] - pOffsets[0]));
+}
+
+inline QString FBBPlayer::Name() const
+{
+    const uint32_t* pOffsets = m_pColumns->stringOffsets.data() + 2 * m_row;
+    return QString(m_pColumns->pool.data() + pOffsets[1], int(pOffsets[2] - pOffsets[1]));
+}
+
+inline FBBPlayerHandle& FBBPlayer::Handle() { return m_pColumns->handle[m_row]; }
+inline FBBPlayerHandle FBBPlayer::Handle() const { return m_pColumns->handle[m_row]; }
+inline FBBTeam& FBBPlayer::Team() { return m_pColumns->team[m_row]; }
+inline FBBTeam FBBPlayer::Team() const { return m_pColumns->team[m_row]; }
+inline uint32_t& FBBPlayer::Age() { return m_pColumns->age[m_row]; }
+inline uint32_t FBBPlayer::Age() const { return m_pColumns->age[m_row]; }
+inline uint32_t& FBBPlayer::Experience() { return m_pColumns->experience[m_row]; }
+inline uint32_t FBBPlayer::Experience() const { return m_pColumns->experience[m_row]; }
+
+inline uint32_t& FBBPlayer::Hitting(HittingStats stat)
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_HITTER);
+    return m_pColumns->stats[stat][m_row];
+}
+
+inline uint32_t FBBPlayer::Hitting(HittingStats stat) const
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_HITTER);
+    return m_pColumns->stats[stat][m_row];
+}
+
+inline uint32_t& FBBPlayer::Pitching(PitchingStats stat)
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_PITCHER);
+    return m_pColumns->stats[stat][m_row];
+}
+
+inline uint32_t FBBPlayer::Pitching(PitchingStats stat) const
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_PITCHER);
+    return m_pColumns->stats[stat][m_row];
+}
+
+inline float& FBBPlayer::Appearances(Fielding position) { return m_pColumns->fielding[position][m_row]; }
+inline float FBBPlayer::Appearances(Fielding position) const { return m_pColumns->fielding[position][m_row]; }
+
+inline float& FBBPlayer::ZHitting(HittingCategory category)
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_HITTER);
+    return m_pColumns->z[category][m_row];
+}
+
+inline float FBBPlayer::ZHitting(HittingCategory category) const
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_HITTER);
+    return m_pColumns->z[category][m_row];
+}
+
+inline float& FBBPlayer::ZPitching(PitchingCategory category)
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_PITCHER);
+    return m_pColumns->z[category][m_row];
+}
+
+inline float FBBPlayer::ZPitching(PitchingCategory category) const
+{
+    Q_ASSERT(m_type == PLAYER_TYPE_PITCHER);
+    return m_pColumns->z[category][m_row];
+}
+
+inline float& FBBPlayer::ZScore() { return m_pColumns->zScore[m_row]; }
+inline float FBBPlayer::ZScore() const { return m_pColumns->zScore[m_row]; }
+inline float FBBPlayer::Estimate() const
+{
+    // Undrafted players in the pool are priced against the current replacement
+    // level, everyone else keeps the estimate frozen when they were drafted
+    if (m_pColumns->owner[m_row] == 0 && m_pColumns->pooled[m_row] != 0) {
+        return (m_pColumns->zScore[m_row] + m_pColumns->scarcity[m_row] - m_pColumns->replacementZ) * m_pColumns->costPerZ;
+    }
+    return FrozenEstimate();
+}
+inline float FBBPlayer::FrozenEstimate() const { return m_pColumns->estimate[m_row]; }
+inline void FBBPlayer::FreezeEstimate() { m_pColumns->estimate[m_row] = Estimate(); }
+inline float& FBBPlayer::BaseValue() { return m_pColumns->baseValue[m_row]; }
+inline float FBBPlayer::BaseValue() const { return m_pColumns->baseValue[m_row]; }
+inline float FBBPlayer::MarketPrice() const { return m_pColumns->marketPrice[m_row]; }
+inline float FBBPlayer::MarketLow() const { return m_pColumns->marketLow[m_row]; }
+inline float FBBPlayer::MarketHigh() const { return m_pColumns->marketHigh[m_row]; }
+inline float FBBPlayer::Available() const { return m_pColumns->available[m_row]; }
+inline uint32_t& FBBPlayer::Rank() { return m_pColumns->rank[m_row]; }
+inline uint32_t FBBPlayer::Rank() const { return m_pColumns->rank[m_row]; }
+
+inline FBBOwnerId& FBBPlayer::Owner() { return m_pColumns->owner[m_row]; }
+inline FBBOwnerId FBBPlayer::Owner() const { return m_pColumns->owner[m_row]; }
+inline uint32_t& FBBPlayer::Paid() { return m_pColumns->paid[m_row]; }
+inline uint32_t FBBPlayer::Paid() const { return m_pColumns->paid[m_row]; }
+inline FBBPositionBits& FBBPlayer::DraftPosition() { return m_pColumns->position[m_row]; }
+inline FBBPositionBits FBBPlayer::DraftPosition() const { return m_pColumns->position[m_row]; }
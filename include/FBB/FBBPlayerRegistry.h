@@ -0,0 +1,59 @@
+#pragma once
+
+#include "FBB/FBBPlayer.h"
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// FBBPlayerRegistry
+//------------------------------------------------------------------------------
+// Interns source player ids (e.g. fangraphs ids) into dense handles. Lookups go
+// through an open-addressing hash table so joins against the player pool are
+// O(1) and only compare bytes on a full hash match. Hitters and pitchers that
+// share a source id (two-way players) share a handle.
+class FBBPlayerRegistry
+{
+public:
+
+    // Assigns the player a handle and indexes it by type
+    FBBPlayerHandle Register(FBBPlayer* pPlayer);
+
+    // Handle for a source id (FBB_INVALID_PLAYER_HANDLE if unknown)
+    FBBPlayerHandle Find(const char* pId, uint32_t size) const;
+    FBBPlayerHandle Find(const QByteArray& id) const;
+    FBBPlayerHandle Find(const QString& id) const;
+
+    // Player for a handle (nullptr if there is no player of that type)
+    FBBPlayer* Player(FBBPlayerHandle handle, FBBPlayer::PlayerType type) const;
+
+    uint32_t Count() const { return static_cast<uint32_t>(m_offsets.size()) - 1; }
+    void Clear();
+
+private:
+
+    struct Slot
+    {
+        uint32_t hash = 0;
+        FBBPlayerHandle handle = FBB_INVALID_PLAYER_HANDLE;
+    };
+
+    static uint32_t Hash(const char* pId, uint32_t size);
+    FBBPlayerHandle Intern(const char* pId, uint32_t size);
+    size_t FindSlot(const char* pId, uint32_t size, uint32_t hash) const;
+    void Grow();
+
+    // Hash table (power of two, linear probing)
+    std::vector<Slot> m_slots;
+
+    // Interned ids (handle -> [offset, next offset) in the pool)
+    std::vector<char> m_pool;
+    std::vector<uint32_t> m_offsets = { 0 };
+
+    // Players by handle
+    std::vector<FBBPlayer*> m_hitters;
+    std::vector<FBBPlayer*> m_pitchers;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "FBB/FBBPlayer.h"
+
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// FBBPlayerStore
+//------------------------------------------------------------------------------
+// Columnar storage for the player pool. Hitters and pitchers are kept in
+// separate partitions so each stat column is a dense array of just the players
+// that have it. FBBPlayer views handed out by the store stay valid for its
+// lifetime.
+class FBBPlayerStore
+{
+public:
+
+    FBBPlayerStore();
+    FBBPlayerStore(const FBBPlayerStore&) = delete;
+    FBBPlayerStore& operator=(const FBBPlayerStore&) = delete;
+
+    // Appends a player (all other fields zeroed) and returns its view
+    FBBPlayer* Add(FBBPlayer::PlayerType type, const QString& id, const QString& name);
+    void Reserve(FBBPlayer::PlayerType type, uint32_t count);
+
+    // Players of one type, or all of them (hitters then pitchers)
+    uint32_t Count(FBBPlayer::PlayerType type) const { return Columns(type).Count(); }
+    FBBPlayer* Player(FBBPlayer::PlayerType type, uint32_t row) { return &Views(type)[row]; }
+    std::vector<FBBPlayer*> Players();
+
+    // Raw columns for kernels that sweep a whole partition
+    FBBPlayerColumns& Columns(FBBPlayer::PlayerType type);
+    const FBBPlayerColumns& Columns(FBBPlayer::PlayerType type) const;
+
+private:
+
+    std::deque<FBBPlayer>& Views(FBBPlayer::PlayerType type);
+
+    FBBPlayerColumns m_hitters;
+    FBBPlayerColumns m_pitchers;
+
+    // Deque so views never move as players are added
+    std::deque<FBBPlayer> m_hitterViews;
+    std::deque<FBBPlayer> m_pitcherViews;
+};
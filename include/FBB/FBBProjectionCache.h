@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+class FBBPlayerStore;
+
+//------------------------------------------------------------------------------
+// FBBProjectionCache
+//------------------------------------------------------------------------------
+// Versioned binary snapshot of parsed projections. Stats are stored column by
+// column (hitters and pitchers partitioned) along with an interned string table
+// for ids and names. The snapshot is keyed by a content hash of the source CSVs
+// and memory-mapped when loaded.
+class FBBProjectionCache
+{
+public:
+
+    // Content hash of the source files
+    static QByteArray HashSources(const QStringList& files);
+
+    // Location of the snapshot in the cache directory
+    static QString SnapshotPath();
+
+    // Loads players into an empty store. Returns false (and leaves the store
+    // untouched) if the snapshot is missing, stale or malformed.
+    static bool Load(const QByteArray& hash, FBBPlayerStore& store);
+
+    // Writes a snapshot of the store
+    static bool Save(const QByteArray& hash, const FBBPlayerStore& store);
+};
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBPlayerRegistry.h"
 
 #include <QObject>
+#include <QFutureWatcher>
+#include <memory>
 #include <vector>
 
 class FBBPlayer;
+class FBBPlayerStore;
 
 //------------------------------------------------------------------------------
 // FBBProjectionService
@@ -16,11 +20,62 @@ class FBBProjectionService : public QObject
 
 public:
 
+    enum class LoadMode
+    {
+        Serial,     // Parse one file at a time in a single chunk
+        Parallel,   // Parse all files at once in row aligned chunks on the thread pool
+    };
+
     static FBBProjectionService& Instance();
     FBBProjectionService(QObject* parent);
+
+    // Starts loading projections on the thread pool. The draft board model is
+    // reset on this object's thread once loading finishes.
     void LoadProjections();
+    bool IsLoading() const { return m_loading; }
+    bool IsLoaded() const { return m_loaded; }
+
+    // Loaded players and source id lookups into them
+    FBBPlayerStore* Store() const { return m_spStore.get(); }
+    const FBBPlayerRegistry& Registry() const { return m_registry; }
+
+    void SetLoadMode(LoadMode mode) { m_loadMode = mode; }
+    LoadMode GetLoadMode() const { return m_loadMode; }
+
+    // Loads projections from these files in a directory instead of the bundled
+    // ones (an empty directory goes back to the bundled projections)
+    static const char* const HITTING_FILE_NAME;
+    static const char* const PITCHING_FILE_NAME;
+    static const char* const APPEARANCE_FILE_NAME;
+    void SetSourceDirectory(const QString& directory) { m_sourceDirectory = directory; }
+    const QString& SourceDirectory() const { return m_sourceDirectory; }
+
+signals:
+    void LoadProgress(const QString& message);
+    void ProjectionsLoaded();
 
 private:
-    void LoadPitchingProjections(std::vector<FBBPlayer*>& vecPlayers, const QString& file);
-    void LoadHittingProjections(std::vector<FBBPlayer*>& vecPlayers, const QString& file);
-};
\ No newline at end of file
+    struct FieldingRow;
+
+    struct LoadResult
+    {
+        std::shared_ptr<FBBPlayerStore> spStore;
+        FBBPlayerRegistry registry;
+    };
+
+    LoadResult LoadPlayers();
+    void LoadPitchingProjections(FBBPlayerStore& store, const QString& file);
+    void LoadHittingProjections(FBBPlayerStore& store, const QString& file);
+    std::vector<FieldingRow> LoadFielding(const QString& file);
+    static void JoinFielding(const FBBPlayerRegistry& registry, const std::vector<FieldingRow>& vecRows);
+    size_t ChunkCount(const char* pBegin, const char* pEnd) const;
+    void OnPlayersLoaded();
+
+    LoadMode m_loadMode = LoadMode::Parallel;
+    QString m_sourceDirectory;
+    QFutureWatcher<LoadResult>* m_pWatcher = nullptr;
+    std::shared_ptr<FBBPlayerStore> m_spStore;
+    FBBPlayerRegistry m_registry;
+    bool m_loading = false;
+    bool m_loaded = false;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QVariant>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// FBBRenderCache
+//------------------------------------------------------------------------------
+// Formatted cell values of a table model (display strings and tooltips), kept
+// until the row or column they're in changes. Every invalidation takes the
+// next epoch and stamps it on the rows or columns it covers; a cell is current
+// if it was filled at or after both stamps (unfilled cells have epoch 0).
+// Invalidating is O(rows or columns) and rows are only allocated once a view
+// asks for them.
+class FBBRenderCache
+{
+public:
+
+    enum Slot
+    {
+        SLOT_DISPLAY,
+        SLOT_TOOL_TIP,
+
+        Slot_Count
+    };
+
+    // Drops everything for a table of this shape
+    void Reset(size_t rows, size_t columns);
+
+    void InvalidateRows(size_t first, size_t last);
+    void InvalidateColumns(size_t first, size_t last);
+
+    // Current value of a cell or null
+    const QVariant* Find(size_t row, size_t column, Slot slot) const;
+    void Store(size_t row, size_t column, Slot slot, const QVariant& value);
+
+private:
+
+    struct Cell
+    {
+        uint64_t epoch = 0;
+        QVariant value;
+    };
+
+    uint64_t m_epoch = 1;
+    size_t m_columns = 0;
+    std::vector<uint64_t> m_vecRowEpoch;
+    std::vector<uint64_t> m_vecColumnEpoch;
+    std::vector<std::unique_ptr<Cell[]>> m_vecRows;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FBB/FBBRosterPlanner.h"
+
+#include <QWidget>
+
+class QComboBox;
+class QLabel;
+class QTableWidget;
+class QTimer;
+
+// "Your plan" panel: the players an owner should target with the money and
+// slots they have left (see FBBRosterPlanner)
+class FBBRosterPlan : public QWidget
+{
+    Q_OBJECT
+
+public:
+    FBBRosterPlan(QWidget* pParent);
+
+private:
+    void UpdateOwners();
+    void Replan();
+
+    // Replans once control returns to the event loop, however many changes
+    // asked for it before then
+    void ScheduleReplan();
+
+    FBBRosterPlanner m_planner;
+    QTimer* m_pReplanTimer;
+    QComboBox* m_pOwner;
+    QLabel* m_pSummary;
+    QTableWidget* m_pTable;
+};
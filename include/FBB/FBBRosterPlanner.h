@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBPlayer.h"
+#include "FBB/FBBRosterSlots.h"
+
+#include <cstdint>
+#include <vector>
+
+// Roster slots of one team for a player type
+std::vector<FBBRosterSlots::Slot> FBBTeamSlots(const FBBLeaugeSettings& settings, FBBPlayer::PlayerType type);
+
+//------------------------------------------------------------------------------
+// FBBRosterPlanner
+//------------------------------------------------------------------------------
+// Picks the set of players an owner should target with the money they have
+// left: the most total value that fits their open slots, keeping $1 back for
+// every slot the plan leaves empty. It's a knapsack with position constraints
+// solved by branch and bound over candidates in descending value:
+//
+//  - a candidate is dominated by an earlier one that can play every position
+//    it can, costs no more and is worth no less. Skipping a candidate rules
+//    out everyone it dominates (a bitset per candidate), and a candidate with
+//    at least as many dominators as there are open slots is never needed.
+//  - the bound is the Lagrangian relaxation of the budget: for a price per
+//    dollar spent, the best open-slot count of (value - price * cost).
+//
+// Each solve starts from the previous plan (minus anyone drafted since),
+// topped up greedily, so the search begins with a good incumbent and can stop
+// at a time budget with the best plan found so far.
+class FBBRosterPlanner
+{
+public:
+
+    struct Candidate
+    {
+        uint32_t id;
+        FBBPositionMask eligible;
+
+        // Expected price (at least $1) and value in dollars
+        uint32_t cost;
+        float value;
+    };
+
+    struct Plan
+    {
+        std::vector<uint32_t> vecIds;
+        uint32_t cost = 0;
+        float value = 0.f;
+
+        // False if the time budget ran out before the search finished
+        bool optimal = false;
+    };
+
+    // Plans for the open slots of roster with budget dollars, searching for at
+    // most budgetMs milliseconds. Players already on the roster may move to
+    // other positions they're eligible for to make room.
+    const Plan& Solve(const FBBRosterSlots& roster, uint32_t budget, const std::vector<Candidate>& vecCandidates, double budgetMs);
+
+    const Plan& Current() const { return m_plan; }
+    void Clear() { m_plan = Plan(); }
+
+private:
+
+    Plan m_plan;
+};
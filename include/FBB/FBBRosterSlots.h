@@ -0,0 +1,68 @@
+#pragma once
+
+#include "FBB/FBBPosition.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// FBBRosterSlots
+//------------------------------------------------------------------------------
+// Assignment of players to the league's roster slots. Placing a player may
+// shuffle already placed players between positions they are eligible for
+// (an augmenting path over slot types), so a player is only turned away when
+// no rearrangement has room for them.
+//
+// Every slot a player can fill is worth the same to them, which makes the
+// feasible rosters a transversal matroid: placing players in descending
+// zScore order and keeping whoever fits gives the maximum total zScore, the
+// same answer as a min-cost assignment.
+class FBBRosterSlots
+{
+public:
+
+    using Slot = std::pair<FBBPositionBits, uint32_t>;
+
+    // Slot counts by position (zero counts are ignored)
+    explicit FBBRosterSlots(const std::vector<Slot>& vecSlots);
+
+    // Places a player (by id) if some arrangement has room for them
+    bool Place(uint32_t id, FBBPositionMask eligible);
+
+    // Positions with at least one slot
+    FBBPositionMask Positions() const { return m_positions; }
+    bool IsFull() const { return m_open == 0; }
+
+    // Unfilled slots over all positions
+    uint32_t OpenSlots() const { return m_open; }
+
+private:
+
+    struct Entry
+    {
+        uint32_t id;
+        FBBPositionMask eligible;
+    };
+
+    struct Position
+    {
+        FBBPositionBits position;
+        uint32_t count;
+        std::vector<Entry> vecPlaced;
+    };
+
+    std::vector<Position> m_vecPositions;
+    FBBPositionMask m_positions = 0;
+    uint32_t m_open = 0;
+
+    // Search scratch (indexed like m_vecPositions)
+    struct Parent
+    {
+        int32_t position;
+        int32_t index;
+    };
+    std::vector<Parent> m_vecParent;
+    std::vector<uint8_t> m_vecVisited;
+    std::vector<uint32_t> m_vecQueue;
+};
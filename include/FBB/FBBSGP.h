@@ -0,0 +1,27 @@
+#pragma once
+
+#include "FBB/FBBCategory.h"
+#include "FBB/FBBLeaugeSettings.h"
+
+#include <QByteArray>
+
+#include <cstddef>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Standings gain points
+//------------------------------------------------------------------------------
+// An SGP denominator is how much of a category it takes to gain one place in
+// the standings. They are either set by hand, fitted from past standings or
+// left at the category defaults.
+
+// Denominators of vecCategories (parallel to it)
+std::vector<float> FBBSGPDenominators(FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const FBBLeaugeSettings::SGP& sgp);
+
+// Fits denominators from final standings. The CSV has one row per team and a
+// column per category, named like the category ("P:" in front of a pitching
+// name picks it over the hitting category of the same name). An optional
+// "Season" column holds several years, fitted separately and averaged. Each
+// denominator is the least squares slope of the category against standings
+// places. Returns the number of categories fitted.
+size_t FBBFitSGPDenominators(const QByteArray& csv, FBBLeaugeSettings::SGP& sgp);
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBSimulationRunner.h"
+
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+class FBBPlayerStore;
+
+//------------------------------------------------------------------------------
+// FBBSeasonSimulator
+//------------------------------------------------------------------------------
+// Plays the season out many times from the drafted rosters and ranks the
+// owners in roto points. Each trial draws a playing time factor per player
+// (shared by all of their categories) and a performance factor per player and
+// category around the projection, sums the owners' category totals and scores
+// the standings.
+//
+// Categories are stored column-wise with every owner's players next to each
+// other, so a trial samples one category at a time for all players and sums
+// contiguous runs. Normal deviates come from a quantile table indexed by
+// random bits, five per 64-bit draw.
+//
+// Trials run on an FBBSimulationRunner like FBBAuctionSimulator's, so the
+// results only depend on the seed and trial count.
+class FBBSeasonSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    struct Category
+    {
+        QString name;
+        bool isRate;
+        float sign;
+
+        // Players of each owner are [vecOwnerBegin[o], vecOwnerBegin[o + 1])
+        std::vector<uint32_t> vecOwnerBegin;
+
+        // Contributions (the player index picks the playing time factor)
+        std::vector<uint32_t> vecPlayer;
+        std::vector<float> vecNum;
+        std::vector<float> vecDen;
+    };
+
+    struct State
+    {
+        std::vector<FBBOwnerId> vecOwners;
+        std::vector<Category> vecCategories;
+        uint32_t numPlayers = 0;
+    };
+
+    struct Results
+    {
+        uint32_t trials = 0;
+
+        // Chance of finishing in each place (owner-major: owner * owners + place)
+        std::vector<float> vecFinish;
+
+        // Expected roto points by category (owner * categories + category)
+        std::vector<float> vecPoints;
+
+        // Expected total points by owner
+        std::vector<float> vecTotal;
+    };
+
+    // Snapshot of the drafted rosters scored in the league's categories
+    static State FromDraft(const FBBPlayerStore& store, const FBBLeaugeSettings& settings);
+
+    FBBSeasonSimulator(QObject* parent = nullptr);
+    ~FBBSeasonSimulator();
+
+    // Cancels any running trials and starts numTrials new ones
+    void Start(const State& state, uint32_t numTrials, uint64_t seed);
+
+    // Stops the workers (returns without waiting for them)
+    void Cancel();
+
+    const State& Snapshot() const { return m_state; }
+    Results Current() const;
+    uint32_t Completed() const { return m_runner.Completed(); }
+    uint32_t Total() const { return m_runner.Total(); }
+
+signals:
+    void Progress(uint32_t completed, uint32_t total);
+
+private:
+
+    struct Tally
+    {
+        std::vector<uint32_t> vecFinish;
+        std::vector<double> vecPoints;
+        uint32_t trials = 0;
+
+        void Reset(size_t numOwners, size_t numCategories);
+        void Merge(const Tally& tally);
+    };
+
+    // Per worker scratch
+    struct Scratch
+    {
+        std::vector<float> vecPlayingTime;
+        std::vector<float> vecDeviates;
+        std::vector<float> vecValues;
+        std::vector<float> vecTotals;
+    };
+
+    class Worker;
+
+    void Trial(std::mt19937_64& rng, Tally& tally, Scratch& scratch) const;
+
+    FBBSimulationRunner m_runner;
+
+    // Immutable while the workers run
+    State m_state;
+
+    // Guarded by the runner's mutex
+    Tally m_tally;
+};
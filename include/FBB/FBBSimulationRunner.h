@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QThreadPool>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+
+//------------------------------------------------------------------------------
+// FBBSimulationRunner
+//------------------------------------------------------------------------------
+// Runs a count of independent simulations on a thread pool, for
+// FBBAuctionSimulator and FBBSeasonSimulator.
+//
+// Simulations are handed out to the workers in batches from a shared counter,
+// so a worker that finishes early just claims more. Every simulation reseeds
+// the worker's generator from its own index, which makes the results depend
+// only on the seed and count, not on the thread count or scheduling. After
+// each batch a worker publishes its tallies under the runner's lock, and
+// progress is reported (throttled) from the worker thread.
+class FBBSimulationRunner
+{
+public:
+
+    // One worker's tallies and scratch
+    class Worker
+    {
+    public:
+        virtual ~Worker() {}
+
+        // Runs one simulation
+        virtual void Run(std::mt19937_64& rng) = 0;
+
+        // Folds the batch run since the last call into the shared results
+        // (called with Mutex() held)
+        virtual void Publish() = 0;
+    };
+
+    using WorkerFactory = std::function<std::unique_ptr<Worker>()>;
+    using ProgressCallback = std::function<void(uint32_t completed, uint32_t total)>;
+
+    FBBSimulationRunner(uint32_t batchSize);
+    ~FBBSimulationRunner();
+
+    // Cancels the running simulations and waits for the workers to return
+    void Stop();
+
+    // Starts total simulations (stop first). Reports progress right away when
+    // there's nothing to run.
+    void Start(uint32_t total, uint64_t seed, WorkerFactory factory, ProgressCallback progress);
+
+    // Stops the workers (returns without waiting for them)
+    void Cancel();
+
+    uint32_t Completed() const { return m_completed; }
+    uint32_t Total() const { return m_total; }
+
+    // Guards whatever Worker::Publish writes
+    std::mutex& Mutex() const { return m_mutex; }
+
+private:
+
+    void Work();
+
+    const uint32_t m_batchSize;
+    QThreadPool m_pool;
+    std::atomic<bool> m_cancel;
+    std::atomic<uint32_t> m_next;
+    std::atomic<uint32_t> m_completed;
+
+    // Immutable while the workers run
+    uint32_t m_total = 0;
+    uint64_t m_seed = 0;
+    WorkerFactory m_factory;
+    ProgressCallback m_progress;
+
+    mutable std::mutex m_mutex;
+    int64_t m_lastProgress = 0;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QWidget>
+
+class FBBSeasonSimulator;
+class QLabel;
+class QTableWidget;
+
+class FBBStandings : public QWidget
+{
+    Q_OBJECT
+
+public:
+    FBBStandings(QWidget* pParent);
+
+private:
+    void Simulate();
+    void Refresh();
+
+    FBBSeasonSimulator* m_pSimulator;
+    QLabel* m_pStatus;
+    QTableWidget* m_pFinish;
+    QTableWidget* m_pCategories;
+    bool m_simulated = false;
+};
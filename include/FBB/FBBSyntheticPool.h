@@ -0,0 +1,42 @@
+#pragma once
+
+#include "FBB/FBBPlayer.h"
+
+#include <array>
+#include <cstdint>
+
+class FBBPlayerStore;
+
+//------------------------------------------------------------------------------
+// FBBSyntheticPool
+//------------------------------------------------------------------------------
+// Generates a player pool of any size for scale testing. Each player gets a
+// playing time share and a few talent draws (contact, power, speed, discipline
+// for hitters; run prevention and strikeouts for pitchers) that their counting
+// stats are derived from, so the categories correlate the way real projections
+// do. Pools only depend on the options, and draws come straight from the
+// generator's bits rather than the library distributions, which differ between
+// standard libraries.
+class FBBSyntheticPool
+{
+public:
+
+    struct Options
+    {
+        uint32_t numHitters = 0;
+        uint32_t numPitchers = 0;
+        uint64_t seed = 0;
+
+        // Relative weights of hitters' primary positions (indexed by
+        // FBBPlayer::Fielding) and of bats that only DH
+        std::array<float, FBBPlayer::Fielding_Count> positionMix = {{ 13, 11, 12, 12, 11, 12, 12, 13 }};
+        float dhMix = 4;
+
+        // Shares of hitters with a second position and of pitchers who start
+        float secondaryShare = 0.25f;
+        float starterShare = 0.45f;
+    };
+
+    // Appends the generated players to the store
+    static void Generate(FBBPlayerStore& store, const Options& options);
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+class QString;
+
+//------------------------------------------------------------------------------
+// FBBTrace
+//------------------------------------------------------------------------------
+// Scoped timings written as Chrome trace events (open the file in
+// chrome://tracing or Perfetto). Each thread records into its own ring of
+// recent events without taking a lock, so tracing can stay on in normal use;
+// Write() copies the rings while threads keep recording and drops anything
+// overwritten mid-copy.
+//
+// Spans are named by string literals, which are kept as pointers and written
+// as they are. Builds without FBB_TRACE compile FBB_TRACE_SCOPE to nothing.
+class FBBTrace
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+    // Completed span on the calling thread
+    static void Record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+    // Everything still in the rings as trace event JSON
+    static bool Write(const QString& file);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+class FBBTraceScope
+{
+public:
+
+    explicit FBBTraceScope(const char* name)
+        : m_name(FBBTrace::IsEnabled() ? name : nullptr)
+    {
+        if (m_name) {
+            m_begin = FBBTrace::Clock::now();
+        }
+    }
+
+    ~FBBTraceScope()
+    {
+        if (m_name) {
+            FBBTrace::Record(m_name, m_begin, FBBTrace::Clock::now());
+        }
+    }
+
+    FBBTraceScope(const FBBTraceScope&) = delete;
+    FBBTraceScope& operator=(const FBBTraceScope&) = delete;
+
+private:
+    const char* m_name;
+    FBBTrace::Clock::time_point m_begin;
+};
+
+#ifdef FBB_TRACE
+#define FBB_TRACE_JOIN_(a, b) a##b
+#define FBB_TRACE_JOIN(a, b) FBB_TRACE_JOIN_(a, b)
+#define FBB_TRACE_SCOPE(name) FBBTraceScope FBB_TRACE_JOIN(fbbTraceScope, __LINE__)(name)
+#else
+#define FBB_TRACE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "FBB/FBBPosition.h"
+#include "FBB/FBBRosterSlots.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FBBPlayerColumns;
+
+//------------------------------------------------------------------------------
+// FBBValuation
+//------------------------------------------------------------------------------
+// Auction prices for one partition of the player pool. Reset finds the
+// replacement level by selection in O(n), which is all a one-off valuation
+// needs. Ranking the pool is a separate step, done on demand: it sorts by
+// zScore and builds Fenwick trees over that order tracking how many undrafted
+// players are left and the sum of their zScores, so each later pick updates
+// the replacement level and dollars per z in O(log n). Player estimates are
+// derived from those two values when read (see FBBPlayer::Estimate) so they
+// never have to be rewritten.
+//
+// Valuing by position fills every roster slot (see FBBRosterSlots) instead of
+// making one cut, and prices each player against the best player left out at
+// their scarcest position. That reruns the assignment on every pick.
+class FBBValuation
+{
+public:
+
+    // Prices the pool of vecRows. Players that already have an owner count
+    // against the slots and money instead of joining the pool.
+    void Reset(FBBPlayerColumns& columns, const std::vector<uint32_t>& vecRows, size_t numSlots, double totalMoney);
+
+    // Same, with a replacement level per position. vecEligible holds the
+    // eligible positions of every row in the partition.
+    void Reset(FBBPlayerColumns& columns, const std::vector<uint32_t>& vecRows, const std::vector<FBBRosterSlots::Slot>& vecSlots, const std::vector<FBBPositionMask>& vecEligible, double totalMoney);
+
+    // Sorts the pool and fills the rank column (no-op if already ranked)
+    void Rank();
+    bool IsRanked() const { return m_ranked; }
+
+    // Removes a player from the pool (freezing their estimate) or puts them
+    // back. Call before changing the player's owner. Ranks the pool first if
+    // needed.
+    void Draft(uint32_t row, uint32_t paid);
+    void Undraft(uint32_t row, uint32_t paid);
+
+    float ReplacementZ() const { return m_replacementZ; }
+    float CostPerZ() const { return m_costPerZ; }
+
+private:
+
+    void Prepare(FBBPlayerColumns& columns, const std::vector<uint32_t>& vecRows, double totalMoney);
+    void Update(uint32_t position, int32_t count);
+    void Price();
+    void PriceByPosition();
+
+    // Position (in rank order) of the k-th remaining player
+    uint32_t FindRemaining(uint32_t k) const;
+
+    // Sum of remaining zScores ranked ahead of position
+    double SumBefore(uint32_t position) const;
+
+    FBBPlayerColumns* m_pColumns = nullptr;
+
+    // Valid rows (by descending zScore once ranked)
+    std::vector<uint32_t> m_vecRanked;
+    bool m_ranked = false;
+
+    // Fenwick trees (1-based) over ranked positions
+    std::vector<int32_t> m_vecCount;
+    std::vector<double> m_vecSum;
+    uint32_t m_remaining = 0;
+
+    // Slot counts and eligibility when valuing by position
+    std::vector<FBBRosterSlots::Slot> m_vecSlots;
+    std::vector<FBBPositionMask> m_vecEligible;
+
+    size_t m_numSlots = 0;
+    size_t m_numDrafted = 0;
+    double m_totalMoney = 0;
+    double m_spent = 0;
+
+    float m_replacementZ = 0.f;
+    float m_costPerZ = 0.f;
+};
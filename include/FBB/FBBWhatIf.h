@@ -0,0 +1,96 @@
+#pragma once
+
+#include "FBB/FBBInflation.h"
+#include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBPlayer.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+struct FBBCategory;
+class FBBPlayerStore;
+
+//------------------------------------------------------------------------------
+// FBBWhatIf
+//------------------------------------------------------------------------------
+// Answers "what if this owner bought this player at this price" for a batch
+// of candidates at once. A Snapshot captures the draft once: every owner's
+// projected category totals (open roster slots filled with an average player
+// from the pool that is still expected to go) and the inflation tracker. The
+// snapshot is immutable and shared by every evaluation; an evaluation only
+// copies the row of totals of the owner doing the buying, so candidates are
+// independent and run in parallel.
+class FBBWhatIf
+{
+public:
+
+    struct Purchase
+    {
+        FBBPlayer* pPlayer;
+        FBBOwnerId owner;
+        uint32_t price;
+    };
+
+    struct Result
+    {
+        Purchase purchase;
+
+        // Change in the owner's projected roto points and their place after
+        // the purchase (1 is first, 0 if the owner is unknown, the player is
+        // already drafted or the owner has no room for them)
+        float points = 0.f;
+        uint32_t place = 0;
+
+        // Change in the inflation factor of the remaining pool, and what the
+        // player is worth at the inflated price over what was paid
+        float inflation = 0.f;
+        float surplus = 0.f;
+    };
+
+    struct Snapshot
+    {
+        std::vector<FBBOwnerId> vecOwners;
+        std::map<FBBOwnerId, uint32_t> mapOwners;
+
+        // Every enabled category (hitting then pitching) and the first
+        // pitching one
+        std::vector<const FBBCategory*> vecCategories;
+        size_t firstPitching = 0;
+
+        // Average numerator/denominator of a player still to be bought, by
+        // category, and how many hitters and pitchers went into the average
+        std::vector<double> vecFillNum;
+        std::vector<double> vecFillDen;
+        uint32_t numFillHitters = 0;
+        uint32_t numFillPitchers = 0;
+
+        // Open hitting, pitching and bench slots by owner
+        std::vector<uint32_t> vecOpenHitters;
+        std::vector<uint32_t> vecOpenPitchers;
+        std::vector<uint32_t> vecOpenBench;
+
+        // Projected totals, values and roto points (owner * categories + category)
+        std::vector<double> vecNum;
+        std::vector<double> vecDen;
+        std::vector<float> vecValues;
+        std::vector<float> vecPoints;
+        std::vector<float> vecTotals;
+
+        FBBInflation inflation;
+
+        // Projections of the candidates (they don't change during the draft)
+        const FBBPlayerStore* pStore = nullptr;
+    };
+
+    // Captures the current draft
+    static std::shared_ptr<const Snapshot> Capture(const FBBPlayerStore& store, const FBBLeaugeSettings& settings, const FBBInflation& inflation);
+
+    // Evaluates every purchase against the snapshot (on the global thread pool)
+    static std::vector<Result> Evaluate(const std::shared_ptr<const Snapshot>& spSnapshot, const std::vector<Purchase>& vecPurchases);
+
+private:
+
+    static void Evaluate(const Snapshot& snapshot, Result& result);
+};
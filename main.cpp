@@ -1,5 +1,6 @@
 #include "FBB/FBBApplication.h"
 #include "FBB/FBBMainWindow.h"
+#include "FBB/FBBProjectionService.h"
 
 #include <QSplashScreen>
 
@@ -8,6 +9,12 @@ int main(int argc, char *argv[])
     // Application
     FBBApplication app(argc, argv);
 
+    // Optional directory of projections and league settings (see fbb_synth)
+    const QStringList args = app.arguments();
+    if (args.size() > 1) {
+        app.LoadDataDirectory(args[1]);
+    }
+
     // 
     QPixmap pixmap(":/icons/splash.png");
     QSplashScreen splash(pixmap);
@@ -18,8 +25,16 @@ int main(int argc, char *argv[])
     FBBMainWindow mainWin;
     mainWin.resize(1000, 800);
     mainWin.show();
-    splash.finish(&mainWin);
+
+    // Report loading progress on the splash until the projections are in
+    FBBProjectionService& projectionService = FBBProjectionService::Instance();
+    QObject::connect(&projectionService, &FBBProjectionService::LoadProgress, &splash, [&](const QString& message) {
+        splash.showMessage(message, Qt::AlignBottom | Qt::AlignHCenter);
+    });
+    QObject::connect(&projectionService, &FBBProjectionService::ProjectionsLoaded, &splash, [&]() {
+        splash.finish(&mainWin);
+    });
+    projectionService.LoadProjections();
 
     return app.exec();
 }
-
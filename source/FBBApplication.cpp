@@ -1,7 +1,8 @@
 #include "FBB/FBBApplication.h"
 #include "FBB/FBBDraftBoardModel.h"
-#include "FBB/FBBProjectionService.h"
 #include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBProjectionService.h"
+#include "FBB/FBBTrace.h"
 
 #include <QStyleFactory>
 #include <QIcon>
@@ -10,6 +11,8 @@
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
 
 static const char* k_AppName = "Fantasy Baseball";
 
@@ -22,6 +25,9 @@ FBBApplication::FBBApplication(int& argc, char** argv)
 {
     s_instance = this;
 
+    // Revalue the board whenever the league changes
+    connect(m_pSettings, &FBBLeaugeSettings::SettingsChanged, m_pDraftBoardModel, &FBBDraftBoardModel::Recalculate);
+
     Q_INIT_RESOURCE(Resources);
 
     setStyle(QStyleFactory::create("Fusion"));
@@ -59,9 +65,6 @@ FBBApplication::FBBApplication(int& argc, char** argv)
     });
 
     SetApplicationName();
-
-
-    FBBProjectionService::Instance().LoadProjections();
 }
 
 void FBBApplication::Exit()
@@ -71,7 +74,11 @@ void FBBApplication::Exit()
 
 void FBBApplication::Save()
 {
+    FBB_TRACE_SCOPE("FBBApplication::Save");
+
+    // The league goes with the draft, its owner ids are what the picks refer to
     QJsonObject json = m_pDraftBoardModel->ToJson();
+    json["settings"] = m_pSettings->ToJson();
     QJsonDocument doc(json);
 
     QFile jsonFile(m_file);
@@ -89,6 +96,43 @@ void FBBApplication::SaveAs()
 
 void FBBApplication::Load(const QString& fileName)
 {
+    QFile jsonFile(fileName);
+    if (!jsonFile.open(QFile::ReadOnly)) {
+        return;
+    }
+
+    // Restore the league before the picks (older saves don't have one)
+    const QJsonDocument doc = QJsonDocument::fromJson(jsonFile.readAll());
+    const QJsonObject json = doc.object();
+    if (json.contains("settings")) {
+        m_pSettings->FromJson(json["settings"].toObject());
+        m_pSettings->OnAccept();
+    }
+    m_pDraftBoardModel->FromJson(json);
+    m_file = fileName;
+    emit PathChanged();
+}
+
+bool FBBApplication::ExportCSV(const QString& file)
+{
+    QSaveFile csvFile(file);
+    if (!csvFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    csvFile.write(m_pDraftBoardModel->ToCSV());
+    return csvFile.commit();
+}
+
+void FBBApplication::LoadDataDirectory(const QString& directory)
+{
+    QFile leaugeFile(QDir(directory).filePath(FBBLeaugeSettings::FILE_NAME));
+    if (leaugeFile.open(QFile::ReadOnly)) {
+        const QJsonDocument doc = QJsonDocument::fromJson(leaugeFile.readAll());
+        m_pSettings->FromJson(doc.object());
+        m_pSettings->OnAccept();
+    }
+
+    FBBProjectionService::Instance().SetSourceDirectory(directory);
 }
 
 // Dark theme!
@@ -0,0 +1,228 @@
+#include "FBB/FBBAuctionSimulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Simulations claimed by a worker at a time
+static const uint32_t BATCH_SIZE = 32;
+
+// Log-normal spread of the nomination order and of each owner's bid limit
+static const float NOMINATION_NOISE = 0.20f;
+static const float BID_NOISE = 0.15f;
+
+void FBBAuctionSimulator::Tally::Reset(size_t numPlayers, size_t numPrices)
+{
+    vecPrices.assign(numPlayers * numPrices, 0);
+    vecSoldSoon.assign(numPlayers, 0);
+    simulations = 0;
+}
+
+void FBBAuctionSimulator::Tally::Merge(const Tally& tally)
+{
+    for (size_t i = 0; i < vecPrices.size(); i++) {
+        vecPrices[i] += tally.vecPrices[i];
+    }
+    for (size_t i = 0; i < vecSoldSoon.size(); i++) {
+        vecSoldSoon[i] += tally.vecSoldSoon[i];
+    }
+    simulations += tally.simulations;
+}
+
+class FBBAuctionSimulator::Worker : public FBBSimulationRunner::Worker
+{
+public:
+
+    Worker(FBBAuctionSimulator* pSimulator)
+        : m_pSimulator(pSimulator)
+    {
+        m_tally.Reset(m_pSimulator->m_state.vecPlayers.size(), m_pSimulator->m_numPrices);
+    }
+
+    virtual void Run(std::mt19937_64& rng) override
+    {
+        m_pSimulator->Simulate(rng, m_tally, m_vecOwners, m_vecOrder, m_vecNomination);
+        m_tally.simulations++;
+    }
+
+    virtual void Publish() override
+    {
+        m_pSimulator->m_tally.Merge(m_tally);
+        m_tally.Reset(m_pSimulator->m_state.vecPlayers.size(), m_pSimulator->m_numPrices);
+    }
+
+private:
+
+    FBBAuctionSimulator* m_pSimulator;
+    Tally m_tally;
+    std::vector<Owner> m_vecOwners;
+    std::vector<uint32_t> m_vecOrder;
+    std::vector<float> m_vecNomination;
+};
+
+FBBAuctionSimulator::FBBAuctionSimulator(QObject* parent)
+    : QObject(parent)
+    , m_runner(BATCH_SIZE)
+{
+}
+
+FBBAuctionSimulator::~FBBAuctionSimulator()
+{
+    m_runner.Stop();
+}
+
+void FBBAuctionSimulator::Start(const State& state, uint32_t numSimulations, uint64_t seed)
+{
+    m_runner.Stop();
+
+    m_state = state;
+
+    int32_t maxBudget = 0;
+    for (const Owner& owner : m_state.vecOwners) {
+        maxBudget = std::max(maxBudget, owner.budget);
+    }
+    m_numPrices = size_t(maxBudget) + 1;
+    m_tally.Reset(m_state.vecPlayers.size(), m_numPrices);
+
+    const bool isEmpty = m_state.vecPlayers.empty() || m_state.vecOwners.empty();
+    m_runner.Start(isEmpty ? 0 : numSimulations, seed, [this]() {
+        return std::unique_ptr<FBBSimulationRunner::Worker>(new Worker(this));
+    }, [this](uint32_t completed, uint32_t total) {
+        emit Progress(completed, total);
+    });
+}
+
+void FBBAuctionSimulator::Cancel()
+{
+    m_runner.Cancel();
+}
+
+std::vector<FBBAuctionSimulator::Result> FBBAuctionSimulator::Results() const
+{
+    std::lock_guard<std::mutex> lock(m_runner.Mutex());
+
+    std::vector<Result> ret;
+    if (m_tally.simulations == 0) {
+        return ret;
+    }
+
+    ret.resize(m_state.vecPlayers.size());
+    for (size_t i = 0; i < ret.size(); i++) {
+        const uint32_t* pPrices = m_tally.vecPrices.data() + i * m_numPrices;
+        Result& result = ret[i];
+        result.available = 1.f - m_tally.vecSoldSoon[i] / float(m_tally.simulations);
+
+        uint64_t sold = 0;
+        uint64_t total = 0;
+        for (size_t price = 0; price < m_numPrices; price++) {
+            sold += pPrices[price];
+            total += pPrices[price] * price;
+        }
+        if (sold == 0) {
+            result.meanPrice = result.lowPrice = result.medianPrice = result.highPrice = 0.f;
+            continue;
+        }
+        result.meanPrice = float(double(total) / sold);
+
+        // 10th, 50th and 90th percentiles from the histogram
+        uint64_t running = 0;
+        bool hasLow = false;
+        bool hasMedian = false;
+        for (size_t price = 0; price < m_numPrices; price++) {
+            running += pPrices[price];
+            if (!hasLow && running * 10 >= sold) {
+                result.lowPrice = float(price);
+                hasLow = true;
+            }
+            if (!hasMedian && running * 2 >= sold) {
+                result.medianPrice = float(price);
+                hasMedian = true;
+            }
+            if (running * 10 >= sold * 9) {
+                result.highPrice = float(price);
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
+void FBBAuctionSimulator::Simulate(std::mt19937_64& rng, Tally& tally, std::vector<Owner>& vecOwners, std::vector<uint32_t>& vecOrder, std::vector<float>& vecNomination) const
+{
+    const std::vector<Player>& vecPlayers = m_state.vecPlayers;
+    std::normal_distribution<float> normal;
+    vecOwners = m_state.vecOwners;
+
+    uint32_t open = 0;
+    for (const Owner& owner : vecOwners) {
+        open += owner.hitters + owner.pitchers + owner.bench;
+    }
+
+    // Nominate roughly best first
+    vecNomination.resize(vecPlayers.size());
+    for (size_t i = 0; i < vecPlayers.size(); i++) {
+        vecNomination[i] = vecPlayers[i].value * std::exp(NOMINATION_NOISE * normal(rng));
+    }
+    vecOrder.resize(vecPlayers.size());
+    std::iota(vecOrder.begin(), vecOrder.end(), 0);
+    std::sort(vecOrder.begin(), vecOrder.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return vecNomination[lhs] > vecNomination[rhs];
+    });
+
+    const uint32_t lap = static_cast<uint32_t>(vecOwners.size());
+    uint32_t nominations = 0;
+    for (uint32_t i : vecOrder) {
+        if (open == 0) {
+            break;
+        }
+
+        const Player& player = vecPlayers[i];
+        const bool isHitter = player.type == FBBPlayer::PLAYER_TYPE_HITTER;
+
+        // Every owner with room bids up to their (noisy) value, holding back
+        // $1 for each of their other open slots
+        int32_t winner = -1;
+        float bestLimit = 0.f;
+        float secondLimit = 0.f;
+        uint32_t bidders = 0;
+        for (size_t o = 0; o < vecOwners.size(); o++) {
+            const Owner& owner = vecOwners[o];
+            const uint32_t room = (isHitter ? owner.hitters : owner.pitchers) + owner.bench;
+            const int32_t maxBid = owner.budget - int32_t(owner.hitters + owner.pitchers + owner.bench) + 1;
+            if (room == 0 || maxBid < 1) {
+                continue;
+            }
+
+            const float noise = std::exp(BID_NOISE * normal(rng));
+            const float limit = std::max(1.f, std::min(float(maxBid), player.value * owner.aggression * noise));
+            if (winner < 0 || limit > bestLimit) {
+                secondLimit = bestLimit;
+                bestLimit = limit;
+                winner = int32_t(o);
+            } else if (limit > secondLimit) {
+                secondLimit = limit;
+            }
+            bidders++;
+        }
+        if (winner < 0) {
+            continue;
+        }
+
+        const int32_t price = bidders > 1 ? std::max(1, std::min(int32_t(bestLimit), int32_t(secondLimit) + 1)) : 1;
+        Owner& owner = vecOwners[winner];
+        owner.budget -= price;
+        uint32_t& typeSlots = isHitter ? owner.hitters : owner.pitchers;
+        if (typeSlots > 0) {
+            typeSlots--;
+        } else {
+            owner.bench--;
+        }
+        open--;
+
+        tally.vecPrices[i * m_numPrices + std::min<size_t>(size_t(price), m_numPrices - 1)]++;
+        if (nominations < lap) {
+            tally.vecSoldSoon[i]++;
+        }
+        nominations++;
+    }
+}
@@ -0,0 +1,431 @@
+#include "FBB/FBBCSVReader.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FBB_CSV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static inline uint32_t CountTrailingZeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static inline bool IsStructural(char c)
+{
+    return c == '"' || c == ',' || c == '\n' || c == '\r';
+}
+
+static inline bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+#if FBB_CSV_SSE2
+static inline uint32_t QuoteMask(const char* p)
+{
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'))));
+}
+
+static inline uint32_t StructuralMask(const char* p)
+{
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i quote = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'));
+    const __m128i comma = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(','));
+    const __m128i lf = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'));
+    const __m128i cr = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'));
+    const __m128i any = _mm_or_si128(_mm_or_si128(quote, comma), _mm_or_si128(lf, cr));
+    return static_cast<uint32_t>(_mm_movemask_epi8(any));
+}
+#endif
+
+// Returns true if [pBegin, pEnd) contains an odd number of quotes
+static bool HasOddQuotes(const char* pBegin, const char* pEnd)
+{
+    const char* p = pBegin;
+    uint32_t parity = 0;
+
+#if FBB_CSV_SSE2
+    uint32_t acc = 0;
+    for (; pEnd - p >= 16; p += 16) {
+        acc ^= QuoteMask(p);
+    }
+    acc ^= acc >> 8;
+    acc ^= acc >> 4;
+    acc ^= acc >> 2;
+    acc ^= acc >> 1;
+    parity = acc & 1;
+#endif
+
+    for (; p < pEnd; p++) {
+        parity ^= (*p == '"') ? 1 : 0;
+    }
+
+    return parity != 0;
+}
+
+//------------------------------------------------------------------------------
+// FBBCSVField
+//------------------------------------------------------------------------------
+
+QString FBBCSVField::ToString() const
+{
+    return QString::fromUtf8(m_pData, static_cast<int>(m_size));
+}
+
+uint32_t FBBCSVField::ToUInt() const
+{
+    const char* p = m_pData;
+    const char* pEnd = m_pData + m_size;
+
+    // Trim
+    while (p < pEnd && IsSpace(*p)) {
+        p++;
+    }
+    while (pEnd > p && IsSpace(pEnd[-1])) {
+        pEnd--;
+    }
+    if (p < pEnd && *p == '+') {
+        p++;
+    }
+    if (p == pEnd) {
+        return 0;
+    }
+
+    uint64_t value = 0;
+    for (; p < pEnd; p++) {
+        const uint32_t digit = static_cast<uint32_t>(*p - '0');
+        if (digit > 9) {
+            return 0;
+        }
+        value = value * 10 + digit;
+        if (value > UINT32_MAX) {
+            return 0;
+        }
+    }
+
+    return static_cast<uint32_t>(value);
+}
+
+float FBBCSVField::ToFloat() const
+{
+    static const double s_pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+    };
+
+    const char* p = m_pData;
+    const char* pEnd = m_pData + m_size;
+
+    // Trim
+    while (p < pEnd && IsSpace(*p)) {
+        p++;
+    }
+    while (pEnd > p && IsSpace(pEnd[-1])) {
+        pEnd--;
+    }
+
+    // Sign
+    bool negative = false;
+    if (p < pEnd && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    // Mantissa
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    int32_t digits = 0;
+    bool seenDot = false;
+    for (; p < pEnd; p++) {
+        if (*p == '.' && !seenDot) {
+            seenDot = true;
+            continue;
+        }
+        const uint32_t digit = static_cast<uint32_t>(*p - '0');
+        if (digit > 9) {
+            break;
+        }
+        if (mantissa < 100000000000000000ull) {
+            mantissa = mantissa * 10 + digit;
+            exponent -= seenDot ? 1 : 0;
+        } else {
+            exponent += seenDot ? 0 : 1;
+        }
+        digits++;
+    }
+    if (digits == 0) {
+        return 0.f;
+    }
+
+    // Exponent
+    if (p < pEnd && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExp = false;
+        if (p < pEnd && (*p == '-' || *p == '+')) {
+            negativeExp = *p == '-';
+            p++;
+        }
+        int32_t exp = 0;
+        const char* pExp = p;
+        for (; p < pEnd && uint32_t(*p - '0') <= 9; p++) {
+            exp = exp < 1000 ? exp * 10 + (*p - '0') : exp;
+        }
+        if (p == pExp) {
+            return 0.f;
+        }
+        exponent += negativeExp ? -exp : exp;
+    }
+
+    // Trailing garbage makes the whole cell invalid
+    if (p != pEnd) {
+        return 0.f;
+    }
+
+    double value = double(mantissa);
+    while (exponent > 0) {
+        const int32_t step = exponent > 18 ? 18 : exponent;
+        value *= s_pow10[step];
+        exponent -= step;
+    }
+    while (exponent < 0) {
+        const int32_t step = -exponent > 18 ? 18 : -exponent;
+        value /= s_pow10[step];
+        exponent += step;
+    }
+
+    return static_cast<float>(negative ? -value : value);
+}
+
+int FBBCSVField::Compare(const char* str) const
+{
+    const size_t length = std::strlen(str);
+    const size_t common = length < m_size ? length : m_size;
+    const int cmp = common ? std::memcmp(m_pData, str, common) : 0;
+    if (cmp != 0) {
+        return cmp;
+    }
+    if (m_size == length) {
+        return 0;
+    }
+    return m_size < length ? -1 : 1;
+}
+
+//------------------------------------------------------------------------------
+// FBBCSVReader
+//------------------------------------------------------------------------------
+
+FBBCSVReader::FBBCSVReader(const QByteArray& data)
+    : FBBCSVReader(data.constData(), data.constData() + data.size())
+{
+    // Hold a reference so the views stay valid
+    m_data = data;
+}
+
+FBBCSVReader::FBBCSVReader(const char* pBegin, const char* pEnd)
+    : m_pBegin(pBegin)
+    , m_pCursor(pBegin)
+    , m_pEnd(pEnd)
+{
+    // Skip UTF-8 byte order mark
+    if (m_pEnd - m_pCursor >= 3 && std::memcmp(m_pCursor, "\xEF\xBB\xBF", 3) == 0) {
+        m_pCursor += 3;
+    }
+}
+
+std::vector<FBBCSVReader::Range> FBBCSVReader::SplitRows(const char* pBegin, const char* pEnd, size_t count)
+{
+    std::vector<Range> ret;
+    if (pBegin >= pEnd) {
+        return ret;
+    }
+
+    const size_t size = static_cast<size_t>(pEnd - pBegin);
+    count = count == 0 ? 1 : (count > size ? size : count);
+
+    const char* pChunk = pBegin;
+    for (size_t i = 1; i < count && pChunk < pEnd; i++) {
+
+        // Ideal split point (every chunk starts outside of quotes)
+        const char* pTarget = pBegin + (size * i) / count;
+        if (pTarget <= pChunk) {
+            continue;
+        }
+        bool inQuotes = HasOddQuotes(pChunk, pTarget);
+
+        // First newline at or after the target that is outside of quotes
+        const char* p = pTarget;
+        for (; p < pEnd; p++) {
+            if (*p == '"') {
+                inQuotes = !inQuotes;
+            } else if (*p == '\n' && !inQuotes) {
+                break;
+            }
+        }
+        if (p >= pEnd) {
+            break;
+        }
+
+        ret.emplace_back(pChunk, p + 1);
+        pChunk = p + 1;
+    }
+
+    if (pChunk < pEnd) {
+        ret.emplace_back(pChunk, pEnd);
+    }
+
+    return ret;
+}
+
+const FBBCSVField& FBBCSVReader::operator[](size_t index) const
+{
+    static const FBBCSVField s_empty;
+    return index < m_fields.size() ? m_fields[index] : s_empty;
+}
+
+const char* FBBCSVReader::FindStructural(const char* p)
+{
+#if FBB_CSV_SSE2
+    for (;;) {
+
+        // Reload the block if the cursor left it
+        const size_t offset = static_cast<size_t>(p - m_pBegin);
+        if (!m_blockValid || offset < m_blockOffset || offset >= m_blockOffset + 16) {
+            if (m_pEnd - p < 16) {
+                break;
+            }
+            m_blockOffset = offset;
+            m_blockMask = StructuralMask(p);
+            m_blockValid = true;
+        }
+
+        // Next structural character at or after the cursor
+        const uint32_t mask = m_blockMask & (~0u << (offset - m_blockOffset));
+        if (mask) {
+            return m_pBegin + m_blockOffset + CountTrailingZeros(mask);
+        }
+        p = m_pBegin + m_blockOffset + 16;
+    }
+#endif
+
+    // Scalar tail
+    while (p < m_pEnd && !IsStructural(*p)) {
+        p++;
+    }
+    return p;
+}
+
+bool FBBCSVReader::ReadRow()
+{
+    m_fields.clear();
+    m_scratch.clear();
+    m_escaped.clear();
+
+    // Skip blank lines
+    while (m_pCursor < m_pEnd && (*m_pCursor == '\n' || *m_pCursor == '\r')) {
+        m_pCursor++;
+    }
+    if (m_pCursor >= m_pEnd) {
+        return false;
+    }
+
+    const char* p = m_pCursor;
+    for (;;) {
+
+        if (p < m_pEnd && *p == '"') {
+
+            // Quoted field: find the closing quote, skipping "" escapes
+            const char* pStart = p + 1;
+            const char* pClose = pStart;
+            bool escaped = false;
+            for (;;) {
+                pClose = FindStructural(pClose);
+                if (pClose >= m_pEnd) {
+                    break;
+                }
+                if (*pClose != '"') {
+                    pClose++;
+                    continue;
+                }
+                if (pClose + 1 < m_pEnd && pClose[1] == '"') {
+                    escaped = true;
+                    pClose += 2;
+                    continue;
+                }
+                break;
+            }
+
+            if (escaped) {
+                const size_t offset = m_scratch.size();
+                for (const char* c = pStart; c < pClose; c++) {
+                    m_scratch.push_back(*c);
+                    if (*c == '"') {
+                        c++;
+                    }
+                }
+                m_escaped.emplace_back(m_fields.size(), offset);
+                m_fields.emplace_back(nullptr, static_cast<uint32_t>(m_scratch.size() - offset));
+            } else {
+                m_fields.emplace_back(pStart, static_cast<uint32_t>(pClose - pStart));
+            }
+
+            // Anything between the closing quote and the delimiter is dropped
+            p = pClose < m_pEnd ? pClose + 1 : m_pEnd;
+            while (p < m_pEnd && *p != ',' && *p != '\n' && *p != '\r') {
+                p++;
+            }
+
+        } else {
+
+            // Bare field: runs to the next delimiter (stray quotes are literal)
+            const char* pDelim = FindStructural(p);
+            while (pDelim < m_pEnd && *pDelim == '"') {
+                pDelim = FindStructural(pDelim + 1);
+            }
+            m_fields.emplace_back(p, static_cast<uint32_t>(pDelim - p));
+            p = pDelim;
+        }
+
+        // End of input
+        if (p >= m_pEnd) {
+            m_pCursor = m_pEnd;
+            break;
+        }
+
+        // Next field
+        if (*p == ',') {
+            p++;
+            continue;
+        }
+
+        // End of row (\n, \r\n or \r)
+        if (*p == '\r') {
+            p++;
+        }
+        if (p < m_pEnd && *p == '\n') {
+            p++;
+        }
+        m_pCursor = p;
+        break;
+    }
+
+    // Point unescaped fields at the (now stable) scratch buffer
+    for (const auto& escaped : m_escaped) {
+        FBBCSVField& field = m_fields[escaped.first];
+        field = FBBCSVField(m_scratch.data() + escaped.second, field.Size());
+    }
+
+    return true;
+}
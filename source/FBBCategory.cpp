@@ -0,0 +1,689 @@
+#include "FBB/FBBCategory.h"
+#include "FBB/FBBMoments.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+static inline float Stat(const FBBPlayerColumns& columns, uint32_t row, FBBPlayer::HittingStats stat)
+{
+    return float(columns.stats[stat][row]);
+}
+
+static inline float Stat(const FBBPlayerColumns& columns, uint32_t row, FBBPlayer::PitchingStats stat)
+{
+    return float(columns.stats[stat][row]);
+}
+
+// Plate appearances that count towards OBP (sacrifices aren't projected)
+static inline float OnBaseChances(const FBBPlayerColumns& c, uint32_t row)
+{
+    return Stat(c, row, FBBPlayer::HITTING_STAT_AB) + Stat(c, row, FBBPlayer::HITTING_STAT_BB) + Stat(c, row, FBBPlayer::HITTING_STAT_HBP);
+}
+
+static inline float TimesOnBase(const FBBPlayerColumns& c, uint32_t row)
+{
+    return Stat(c, row, FBBPlayer::HITTING_STAT_H) + Stat(c, row, FBBPlayer::HITTING_STAT_BB) + Stat(c, row, FBBPlayer::HITTING_STAT_HBP);
+}
+
+static inline float TotalBases(const FBBPlayerColumns& c, uint32_t row)
+{
+    return Stat(c, row, FBBPlayer::HITTING_STAT_H) +
+        Stat(c, row, FBBPlayer::HITTING_STAT_2B) +
+        2 * Stat(c, row, FBBPlayer::HITTING_STAT_3B) +
+        3 * Stat(c, row, FBBPlayer::HITTING_STAT_HR);
+}
+
+// Quality starts aren't projected. Estimated from starts, scaled down for
+// pitchers who don't average six innings or allow more than 3.5 ERA.
+static inline float EstimatedQS(const FBBPlayerColumns& c, uint32_t row)
+{
+    const float GS = Stat(c, row, FBBPlayer::PITCHING_STAT_GS);
+    const float IP = Stat(c, row, FBBPlayer::PITCHING_STAT_IP);
+    const float ER = Stat(c, row, FBBPlayer::PITCHING_STAT_ER);
+    if (GS == 0 || IP == 0) {
+        return 0.f;
+    }
+    const float depth = std::min(1.f, (IP / GS) / 6.f);
+    const float quality = ER > 0 ? std::min(1.f, 3.5f / (9 * ER / IP)) : 1.f;
+    return GS * depth * quality;
+}
+
+//------------------------------------------------------------------------------
+// FBBCategoryTraits
+//------------------------------------------------------------------------------
+// Extractors of the categories in the common category sets as types, so the
+// kernels below can inline them. The table entries point at the same
+// functions and score them identically through the generic path.
+template <FBBPlayer::PlayerType TYPE, uint32_t INDEX>
+struct FBBCategoryTraits;
+
+struct FBBCountingTraits
+{
+    static const bool IS_RATE = false;
+    static float Denominator(const FBBPlayerColumns&, uint32_t) { return 0.f; }
+};
+
+struct FBBRateTraits
+{
+    static const bool IS_RATE = true;
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_AVG> : FBBRateTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_H); }
+    static float Denominator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_AB); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_HR> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_HR); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_R> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_R); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_RBI> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_RBI); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SB> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_SB); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_OBP> : FBBRateTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return TimesOnBase(c, row); }
+    static float Denominator(const FBBPlayerColumns& c, uint32_t row) { return OnBaseChances(c, row); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SLG> : FBBRateTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return TotalBases(c, row); }
+    static float Denominator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_AB); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_W> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_W); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_SV> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_SV); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_ERA> : FBBRateTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return 9 * Stat(c, row, FBBPlayer::PITCHING_STAT_ER); }
+    static float Denominator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_IP); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_WHIP> : FBBRateTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_BB) + Stat(c, row, FBBPlayer::PITCHING_STAT_H); }
+    static float Denominator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_IP); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_SO> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_SO); }
+};
+
+template <>
+struct FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_QS> : FBBCountingTraits
+{
+    static float Numerator(const FBBPlayerColumns& c, uint32_t row) { return EstimatedQS(c, row); }
+};
+
+static const std::vector<FBBCategory> s_hittingCategories =
+{
+    {
+        "AVG", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_AVG,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_AVG>::Numerator,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_AVG>::Denominator,
+        1.f,
+        0.0018f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.AVG; },
+    },
+    {
+        "HR", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_HR,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_HR>::Numerator,
+        nullptr,
+        1.f,
+        9.5f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.HR; },
+    },
+    {
+        "R", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_R,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_R>::Numerator,
+        nullptr,
+        1.f,
+        21.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.R; },
+    },
+    {
+        "RBI", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_RBI,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_RBI>::Numerator,
+        nullptr,
+        1.f,
+        21.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.RBI; },
+    },
+    {
+        "SB", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SB,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SB>::Numerator,
+        nullptr,
+        1.f,
+        8.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.SB; },
+    },
+    {
+        "OBP", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_OBP,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_OBP>::Numerator,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_OBP>::Denominator,
+        1.f,
+        0.0025f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.OBP; },
+    },
+    {
+        "SLG", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SLG,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SLG>::Numerator,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SLG>::Denominator,
+        1.f,
+        0.0050f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.SLG; },
+    },
+    {
+        // OBP + SLG, weighted by plate appearances
+        "OPS", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_OPS,
+        [](const FBBPlayerColumns& c, uint32_t row) {
+            const float AB = Stat(c, row, FBBPlayer::HITTING_STAT_AB);
+            const float PA = OnBaseChances(c, row);
+            return AB > 0 ? TimesOnBase(c, row) + PA * TotalBases(c, row) / AB : 0.f;
+        },
+        [](const FBBPlayerColumns& c, uint32_t row) { return OnBaseChances(c, row); },
+        1.f,
+        0.0070f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.OPS; },
+    },
+    {
+        "H", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_H,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_H); },
+        nullptr,
+        1.f,
+        30.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.H; },
+    },
+    {
+        "TB", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_TB,
+        [](const FBBPlayerColumns& c, uint32_t row) { return TotalBases(c, row); },
+        nullptr,
+        1.f,
+        45.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.TB; },
+    },
+    {
+        "BB", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_BB,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_BB); },
+        nullptr,
+        1.f,
+        15.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.BB; },
+    },
+    {
+        "RBI+R", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_RBIpR,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_RBI) + Stat(c, row, FBBPlayer::HITTING_STAT_R); },
+        nullptr,
+        1.f,
+        40.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.RBIpR; },
+    },
+    {
+        "xBH", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_xBH,
+        [](const FBBPlayerColumns& c, uint32_t row) {
+            return Stat(c, row, FBBPlayer::HITTING_STAT_2B) + Stat(c, row, FBBPlayer::HITTING_STAT_3B) + Stat(c, row, FBBPlayer::HITTING_STAT_HR);
+        },
+        nullptr,
+        1.f,
+        12.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.xBH; },
+    },
+    {
+        "SB-CS", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_SBmCS,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::HITTING_STAT_SB) - Stat(c, row, FBBPlayer::HITTING_STAT_CS); },
+        nullptr,
+        1.f,
+        6.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.SBmCS; },
+    },
+    {
+        // 2019 linear weights (intentional walks and sacrifices aren't projected)
+        "wOBA", FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::HITTING_CATEGORY_wOBA,
+        [](const FBBPlayerColumns& c, uint32_t row) {
+            const float _2B = Stat(c, row, FBBPlayer::HITTING_STAT_2B);
+            const float _3B = Stat(c, row, FBBPlayer::HITTING_STAT_3B);
+            const float HR = Stat(c, row, FBBPlayer::HITTING_STAT_HR);
+            const float _1B = Stat(c, row, FBBPlayer::HITTING_STAT_H) - _2B - _3B - HR;
+            return 0.69f * Stat(c, row, FBBPlayer::HITTING_STAT_BB) +
+                0.72f * Stat(c, row, FBBPlayer::HITTING_STAT_HBP) +
+                0.89f * _1B + 1.27f * _2B + 1.62f * _3B + 2.10f * HR;
+        },
+        [](const FBBPlayerColumns& c, uint32_t row) { return OnBaseChances(c, row); },
+        1.f,
+        0.0025f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.hitting.wOBA; },
+    },
+};
+
+static const std::vector<FBBCategory> s_pitchingCategories =
+{
+    {
+        "W", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_W,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_W>::Numerator,
+        nullptr,
+        1.f,
+        3.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.W; },
+    },
+    {
+        "SV", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_SV,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_SV>::Numerator,
+        nullptr,
+        1.f,
+        7.5f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.SV; },
+    },
+    {
+        "ERA", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_ERA,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_ERA>::Numerator,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_ERA>::Denominator,
+        -1.f,
+        0.075f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.ERA; },
+    },
+    {
+        "WHIP", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_WHIP,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_WHIP>::Numerator,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_WHIP>::Denominator,
+        -1.f,
+        0.014f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.WHIP; },
+    },
+    {
+        "SO", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_SO,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_SO>::Numerator,
+        nullptr,
+        1.f,
+        30.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.SO; },
+    },
+    {
+        // Opponent AVG (at bats against approximated as 3 * IP + H)
+        "AVG", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_AVG,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_H); },
+        [](const FBBPlayerColumns& c, uint32_t row) { return 3 * Stat(c, row, FBBPlayer::PITCHING_STAT_IP) + Stat(c, row, FBBPlayer::PITCHING_STAT_H); },
+        -1.f,
+        0.0025f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.AVG; },
+    },
+    {
+        "K/9", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_Kp9,
+        [](const FBBPlayerColumns& c, uint32_t row) { return 9 * Stat(c, row, FBBPlayer::PITCHING_STAT_SO); },
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_IP); },
+        1.f,
+        0.15f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.Kp9; },
+    },
+    {
+        "K/BB", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_KpBB,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_SO); },
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_BB); },
+        1.f,
+        0.10f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.KpBB; },
+    },
+    {
+        // The FIP constant is the same for everyone and drops out of the z-score
+        "FIP", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_FIP,
+        [](const FBBPlayerColumns& c, uint32_t row) {
+            return 13 * Stat(c, row, FBBPlayer::PITCHING_STAT_HR) + 3 * Stat(c, row, FBBPlayer::PITCHING_STAT_BB) - 2 * Stat(c, row, FBBPlayer::PITCHING_STAT_SO);
+        },
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_IP); },
+        -1.f,
+        0.070f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.FIP; },
+    },
+    {
+        "HLD", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_HLD,
+        [](const FBBPlayerColumns& c, uint32_t row) { return Stat(c, row, FBBPlayer::PITCHING_STAT_HLD); },
+        nullptr,
+        1.f,
+        6.f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.HLD; },
+    },
+    {
+        "QS", FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_QS,
+        &FBBCategoryTraits<FBBPlayer::PLAYER_TYPE_PITCHER, FBBPlayer::PITCHING_CATEGORY_QS>::Numerator,
+        nullptr,
+        1.f,
+        3.5f,
+        [](const FBBLeaugeSettings::Categories& categories) { return categories.pitching.QS; },
+    },
+};
+
+const std::vector<FBBCategory>& FBBCategories(FBBPlayer::PlayerType type)
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? s_hittingCategories : s_pitchingCategories;
+}
+
+std::vector<const FBBCategory*> FBBEnabledCategories(FBBPlayer::PlayerType type, const FBBLeaugeSettings::Categories& categories)
+{
+    std::vector<const FBBCategory*> ret;
+    for (const FBBCategory& category : FBBCategories(type)) {
+        if (category.isEnabled(categories)) {
+            ret.push_back(&category);
+        }
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// FBBCategoryKernel
+//------------------------------------------------------------------------------
+// Extracts a fixed set of categories (INDICES in ascending order, the order
+// FBBEnabledCategories returns them in) one column at a time. Each column is
+// a tight loop over inlined extractors with no per-row branches or indirect
+// calls. Sets without a kernel go through the table's function pointers.
+using FBBExtract = void (*)(const FBBPlayerColumns& columns, const std::vector<const FBBCategory*>& vecCategories, const uint32_t* pRows, size_t count, float* const* ppNum, float* const* ppDen);
+
+template <typename Traits>
+static void FBBExtractColumn(const FBBPlayerColumns& columns, const uint32_t* pRows, size_t count, float* pNum, float* pDen)
+{
+    for (size_t i = 0; i < count; i++) {
+        pNum[i] = Traits::Numerator(columns, pRows[i]);
+    }
+    if (Traits::IS_RATE) {
+        for (size_t i = 0; i < count; i++) {
+            pDen[i] = Traits::Denominator(columns, pRows[i]);
+        }
+    }
+}
+
+template <uint32_t... INDICES>
+struct FBBCategoryMask;
+
+template <>
+struct FBBCategoryMask<>
+{
+    static const uint32_t VALUE = 0;
+};
+
+template <uint32_t INDEX, uint32_t... REST>
+struct FBBCategoryMask<INDEX, REST...>
+{
+    static const uint32_t VALUE = (1u << INDEX) | FBBCategoryMask<REST...>::VALUE;
+};
+
+template <FBBPlayer::PlayerType TYPE, uint32_t... INDICES>
+struct FBBCategoryKernel
+{
+    static const uint32_t MASK = FBBCategoryMask<INDICES...>::VALUE;
+
+    static void Extract(const FBBPlayerColumns& columns, const std::vector<const FBBCategory*>&, const uint32_t* pRows, size_t count, float* const* ppNum, float* const* ppDen)
+    {
+        size_t k = 0;
+        const int expand[] = { (FBBExtractColumn<FBBCategoryTraits<TYPE, INDICES>>(columns, pRows, count, ppNum[k], ppDen[k]), ++k, 0)... };
+        (void)expand;
+    }
+};
+
+static void FBBExtractGeneric(const FBBPlayerColumns& columns, const std::vector<const FBBCategory*>& vecCategories, const uint32_t* pRows, size_t count, float* const* ppNum, float* const* ppDen)
+{
+    for (size_t k = 0; k < vecCategories.size(); k++) {
+        const FBBCategory& category = *vecCategories[k];
+        float* pNum = ppNum[k];
+        for (size_t i = 0; i < count; i++) {
+            pNum[i] = category.numerator(columns, pRows[i]);
+        }
+        if (category.IsRate()) {
+            float* pDen = ppDen[k];
+            for (size_t i = 0; i < count; i++) {
+                pDen[i] = category.denominator(columns, pRows[i]);
+            }
+        }
+    }
+}
+
+// Standard 5x5, 5x5 with OBP for AVG and 6x6 with OBP and SLG
+using FBBHitting5x5 = FBBCategoryKernel<FBBPlayer::PLAYER_TYPE_HITTER,
+    FBBPlayer::HITTING_CATEGORY_AVG, FBBPlayer::HITTING_CATEGORY_HR, FBBPlayer::HITTING_CATEGORY_R, FBBPlayer::HITTING_CATEGORY_RBI, FBBPlayer::HITTING_CATEGORY_SB>;
+using FBBHitting5x5OBP = FBBCategoryKernel<FBBPlayer::PLAYER_TYPE_HITTER,
+    FBBPlayer::HITTING_CATEGORY_HR, FBBPlayer::HITTING_CATEGORY_R, FBBPlayer::HITTING_CATEGORY_RBI, FBBPlayer::HITTING_CATEGORY_SB, FBBPlayer::HITTING_CATEGORY_OBP>;
+using FBBHitting6x6OBP = FBBCategoryKernel<FBBPlayer::PLAYER_TYPE_HITTER,
+    FBBPlayer::HITTING_CATEGORY_HR, FBBPlayer::HITTING_CATEGORY_R, FBBPlayer::HITTING_CATEGORY_RBI, FBBPlayer::HITTING_CATEGORY_SB, FBBPlayer::HITTING_CATEGORY_OBP, FBBPlayer::HITTING_CATEGORY_SLG>;
+
+// Standard 5x5 and 6x6 with quality starts
+using FBBPitching5x5 = FBBCategoryKernel<FBBPlayer::PLAYER_TYPE_PITCHER,
+    FBBPlayer::PITCHING_CATEGORY_W, FBBPlayer::PITCHING_CATEGORY_SV, FBBPlayer::PITCHING_CATEGORY_ERA, FBBPlayer::PITCHING_CATEGORY_WHIP, FBBPlayer::PITCHING_CATEGORY_SO>;
+using FBBPitching6x6 = FBBCategoryKernel<FBBPlayer::PLAYER_TYPE_PITCHER,
+    FBBPlayer::PITCHING_CATEGORY_W, FBBPlayer::PITCHING_CATEGORY_SV, FBBPlayer::PITCHING_CATEGORY_ERA, FBBPlayer::PITCHING_CATEGORY_WHIP, FBBPlayer::PITCHING_CATEGORY_SO, FBBPlayer::PITCHING_CATEGORY_QS>;
+
+// Picks the kernel for a category set, once per recompute
+static FBBExtract FBBSelectExtract(FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories)
+{
+    uint32_t mask = 0;
+    for (const FBBCategory* pCategory : vecCategories) {
+        // The kernels write their columns in index order
+        if ((mask >> pCategory->index) != 0) {
+            return &FBBExtractGeneric;
+        }
+        mask |= 1u << pCategory->index;
+    }
+
+    if (type == FBBPlayer::PLAYER_TYPE_HITTER) {
+        switch (mask) {
+        case FBBHitting5x5::MASK: return &FBBHitting5x5::Extract;
+        case FBBHitting5x5OBP::MASK: return &FBBHitting5x5OBP::Extract;
+        case FBBHitting6x6OBP::MASK: return &FBBHitting6x6OBP::Extract;
+        default: break;
+        }
+    } else {
+        switch (mask) {
+        case FBBPitching5x5::MASK: return &FBBPitching5x5::Extract;
+        case FBBPitching6x6::MASK: return &FBBPitching6x6::Extract;
+        default: break;
+        }
+    }
+    return &FBBExtractGeneric;
+}
+
+// Per category score of a player: a * numerator + b * denominator + c
+struct FBBCategoryWeights
+{
+    float a;
+    float b;
+    float c;
+};
+
+using FBBWeigh = std::function<FBBCategoryWeights(size_t k, const FBBCategory& category, const FBBMoments& moments)>;
+
+// Extracts every category column by column, takes the moments over vecPool and
+// weighs each category from them. The scores are then a dot product of the
+// weights with the extracted columns.
+static void FBBScoreCategories(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool, const FBBWeigh& weigh)
+{
+    // Clear every category, only the enabled ones get scored
+    for (const FBBCategory& category : FBBCategories(type)) {
+        std::fill(columns.z[category.index].begin(), columns.z[category.index].end(), 0.f);
+    }
+    for (uint32_t row : vecRows) {
+        columns.zScore[row] = 0.f;
+    }
+    if (vecRows.empty() || vecCategories.empty()) {
+        return;
+    }
+
+    // Extracted numerators and denominators, one column per category indexed
+    // like vecRows
+    const size_t numRows = vecRows.size();
+    const size_t numCategories = vecCategories.size();
+    std::vector<std::vector<float>> vecNum(numCategories, std::vector<float>(numRows));
+    std::vector<std::vector<float>> vecDen(numCategories);
+    for (size_t i = 0; i < numCategories; i++) {
+        if (vecCategories[i]->IsRate()) {
+            vecDen[i].resize(numRows);
+        }
+    }
+
+    // Pool membership of each entry of vecRows as a 0/1 weight (none if the
+    // moments are taken over everyone)
+    std::vector<float> vecWeight;
+    if (&vecPool != &vecRows) {
+        std::vector<uint8_t> vecInPool(columns.Count(), 0);
+        for (uint32_t row : vecPool) {
+            vecInPool[row] = 1;
+        }
+        vecWeight.resize(numRows);
+        for (size_t i = 0; i < numRows; i++) {
+            vecWeight[i] = vecInPool[vecRows[i]];
+        }
+    }
+
+    // Each chunk extracts its rows with the category set's kernel and takes
+    // their moments. Large pools are split into chunks whose moments are
+    // merged afterwards.
+    struct Chunk
+    {
+        size_t begin;
+        size_t end;
+        std::vector<FBBMoments> vecMoments;
+    };
+
+    const FBBExtract extract = FBBSelectExtract(type, vecCategories);
+    auto Accumulate = [&](Chunk& chunk) {
+        const size_t count = chunk.end - chunk.begin;
+        std::vector<float*> vecNumColumns(numCategories);
+        std::vector<float*> vecDenColumns(numCategories, nullptr);
+        for (size_t k = 0; k < numCategories; k++) {
+            vecNumColumns[k] = vecNum[k].data() + chunk.begin;
+            if (!vecDen[k].empty()) {
+                vecDenColumns[k] = vecDen[k].data() + chunk.begin;
+            }
+        }
+        extract(columns, vecCategories, vecRows.data() + chunk.begin, count, vecNumColumns.data(), vecDenColumns.data());
+
+        const float* pWeight = vecWeight.empty() ? nullptr : vecWeight.data() + chunk.begin;
+        chunk.vecMoments.resize(numCategories);
+        for (size_t k = 0; k < numCategories; k++) {
+            chunk.vecMoments[k] = FBBMoments::FromColumns(vecNumColumns[k], vecDenColumns[k], pWeight, count);
+        }
+    };
+
+    static const size_t MIN_CHUNK_ROWS = 4096;
+    const size_t numChunks = std::max<size_t>(1, std::min<size_t>(QThreadPool::globalInstance()->maxThreadCount(), numRows / MIN_CHUNK_ROWS));
+    std::vector<Chunk> vecChunks;
+    for (size_t i = 0; i < numChunks; i++) {
+        vecChunks.push_back({ numRows * i / numChunks, numRows * (i + 1) / numChunks, {} });
+    }
+    if (vecChunks.size() == 1) {
+        Accumulate(vecChunks.front());
+    } else {
+        QtConcurrent::blockingMap(vecChunks, Accumulate);
+    }
+
+    std::vector<FBBMoments> vecMoments(numCategories);
+    for (const Chunk& chunk : vecChunks) {
+        for (size_t k = 0; k < numCategories; k++) {
+            vecMoments[k].Merge(chunk.vecMoments[k]);
+        }
+    }
+
+    std::vector<float> vecZScore(numRows, 0.f);
+    for (size_t k = 0; k < numCategories; k++) {
+        const FBBCategory& category = *vecCategories[k];
+        const FBBCategoryWeights weights = weigh(k, category, vecMoments[k]);
+        const std::vector<float>& num = vecNum[k];
+        std::vector<float>& z = columns.z[category.index];
+
+        if (category.IsRate()) {
+            const std::vector<float>& den = vecDen[k];
+            for (size_t i = 0; i < numRows; i++) {
+                const float value = weights.a * num[i] + weights.b * den[i] + weights.c;
+                z[vecRows[i]] = value;
+                vecZScore[i] += value;
+            }
+        } else {
+            for (size_t i = 0; i < numRows; i++) {
+                const float value = weights.a * num[i] + weights.c;
+                z[vecRows[i]] = value;
+                vecZScore[i] += value;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < numRows; i++) {
+        columns.zScore[vecRows[i]] = vecZScore[i];
+    }
+}
+
+void FBBCalculateZScores(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<uint32_t>& vecRows)
+{
+    FBBCalculateZScores(columns, type, vecCategories, vecRows, vecRows);
+}
+
+void FBBCalculateZScores(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool)
+{
+    // Rate categories score num - rate * den, which has a mean of zero and a
+    // variance that follows from the (co)variances of num and den
+    FBBScoreCategories(columns, type, vecCategories, vecRows, vecPool, [](size_t, const FBBCategory& category, const FBBMoments& moments) {
+        if (category.IsRate()) {
+            const double rate = moments.MeanY() > 0 ? moments.MeanX() / moments.MeanY() : 0;
+            const double mean = moments.MeanX() - rate * moments.MeanY();
+            const double variance = moments.VarianceX() - 2 * rate * moments.CovarianceXY() + rate * rate * moments.VarianceY();
+            const double scale = variance > 0 ? category.sign / std::sqrt(variance) : 0;
+            return FBBCategoryWeights{ float(scale), float(-rate * scale), float(-mean * scale) };
+        }
+        const double variance = moments.VarianceX();
+        const double scale = variance > 0 ? category.sign / std::sqrt(variance) : 0;
+        return FBBCategoryWeights{ float(scale), 0.f, float(-moments.MeanX() * scale) };
+    });
+}
+
+void FBBCalculateSGP(FBBPlayerColumns& columns, FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const std::vector<float>& vecDenominators, size_t teamSize, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool)
+{
+    // A rate player moves their team's rate by (num - rate * den) over the
+    // team's total denominator, taken as teamSize average players from the pool
+    FBBScoreCategories(columns, type, vecCategories, vecRows, vecPool, [&](size_t k, const FBBCategory& category, const FBBMoments& moments) {
+        const double denominator = vecDenominators[k];
+        if (denominator <= 0) {
+            return FBBCategoryWeights{ 0.f, 0.f, 0.f };
+        }
+        if (category.IsRate()) {
+            const double rate = moments.MeanY() > 0 ? moments.MeanX() / moments.MeanY() : 0;
+            const double teamDen = teamSize * moments.MeanY();
+            const double scale = teamDen > 0 ? category.sign / (denominator * teamDen) : 0;
+            return FBBCategoryWeights{ float(scale), float(-rate * scale), 0.f };
+        }
+        return FBBCategoryWeights{ float(category.sign / denominator), 0.f, 0.f };
+    });
+}
@@ -3,8 +3,10 @@
 #include "FBB/FBBDraftBoardSortFilterProxyModel.h"
 #include "FBB/FBBDraftDialog.h"
 #include "FBB/FBBApplication.h"
+#include "FBB/FBBRosterPlan.h"
 
 #include <QVBoxLayout>
+#include <QHBoxLayout>
 #include <QTableView>
 #include <QHeaderView>
 #include <QEvent>
@@ -154,89 +156,27 @@ FBBDraftBoard::FBBDraftBoard(QWidget* parent)
     pTableView->setTextElideMode(Qt::ElideRight);
     pTableView->sortByColumn(FBBDraftBoardModel::COLUMN_RANK, Qt::SortOrder::AscendingOrder);
 
-    pTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_ID,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_RANK,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_OWNER,      QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_PAID,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_NAME,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_TEAM,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_AGE,        QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_EXPERIENCE, QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_POSITION,   QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_AB,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_H,          QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_AVG,        QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_HR,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_R,          QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_RBI,        QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_SB,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_AVG,      QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_HR,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_R,        QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_RBI,      QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_SB,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_IP,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_HA,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_BB,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_ER,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_SO,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_ERA,        QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_WHIP,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_W,          QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_SV,         QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_SO,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_ERA,      QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_WHIP,     QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_W,        QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z_SV,       QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_Z,          QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_ESTIMATE,   QHeaderView::Fixed);
-    pTableView->horizontalHeader()->setSectionResizeMode(FBBDraftBoardModel::COLUMN_COMMENT,    QHeaderView::Stretch);
-
+    // Column widths come from the model's column table (0 stretches)
     const int charWidth = fm.averageCharWidth();
     const int padding = pTableView->style()->pixelMetric(QStyle::PM_HeaderMargin);
     pTableView->verticalHeader()->setDefaultSectionSize(fm.height());
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_RANK,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_OWNER,      charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_PAID,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_NAME,       charWidth * 25 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_TEAM,       charWidth * 6 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_AGE,        charWidth * 6 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_EXPERIENCE, charWidth * 6 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_POSITION,   charWidth * 13 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_AB,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_H,          charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_AVG,        charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_HR,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_R,          charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_RBI,        charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_SB,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_AVG,      charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_HR,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_R,        charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_RBI,      charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_SB,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_IP,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_HA,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_BB,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_ER,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_SO,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_ERA,        charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_WHIP,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_W,          charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_SV,         charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_SO,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_ERA,      charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_WHIP,     charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_W,        charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z_SV,       charWidth * 7 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_Z,          charWidth * 10 + padding);
-    pTableView->setColumnWidth(FBBDraftBoardModel::COLUMN_ESTIMATE,   charWidth * 10 + padding);
+    for (int column = 0; column < FBBDraftBoardModel::COLUMN_COUNT; column++) {
+        const int width = FBBDraftBoardModel::ColumnInfo(column).width;
+        if (width > 0) {
+            pTableView->horizontalHeader()->setSectionResizeMode(column, QHeaderView::Fixed);
+            pTableView->setColumnWidth(column, charWidth * width + padding);
+        } else {
+            pTableView->horizontalHeader()->setSectionResizeMode(column, QHeaderView::Stretch);
+        }
+    }
 
     pTableView->hideColumn(FBBDraftBoardModel::COLUMN_ID);
 
-    pLayout->addWidget(pTableView, 1);
+    // Board with the plan panel next to it
+    QHBoxLayout* pBoardLayout = new QHBoxLayout();
+    pBoardLayout->addWidget(pTableView, 1);
+    pBoardLayout->addWidget(new FBBRosterPlan(this));
+    pLayout->addLayout(pBoardLayout, 1);
 
     // Draft button activation
     connect(pTableView->selectionModel(), &QItemSelectionModel::currentRowChanged, this, [=](const QModelIndex& current, const QModelIndex& previous) {
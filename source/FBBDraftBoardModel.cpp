@@ -1,45 +1,242 @@
 #include "FBB/FBBDraftBoardModel.h"
 #include "FBB/FBBProjectionService.h"
 #include "FBB/FBBPlayer.h"
+#include "FBB/FBBPlayerRegistry.h"
+#include "FBB/FBBPlayerStore.h"
 #include "FBB/FBBLeaugeSettings.h"
 #include "FBB/FBBApplication.h"
+#include "FBB/FBBCategory.h"
+#include "FBB/FBBSGP.h"
+#include "FBB/FBBAuctionSimulator.h"
+#include "FBB/FBBRosterPlanner.h"
+#include "FBB/FBBTrace.h"
 
 #include <QColor>
 #include <QJsonArray>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <numeric>
+
 #pragma warning(default : 4061)
 
-template <typename T>
-static QVariant ToQVariant(T x, int role)
+static const int k_AlignText = Qt::AlignLeft | Qt::AlignVCenter;
+static const int k_AlignNumber = Qt::AlignRight | Qt::AlignVCenter;
+
+static QVariant FormatFloat(const QVariant& value)
 {
-    return x;
+    QString str;
+    str.setNum(value.toFloat(), 'f', 3);
+    return str;
 }
 
-static QVariant ToQVariant(float x, int role)
+static QVariant FormatPaid(const QVariant& value)
 {
-    if (role == Qt::DisplayRole) {
-        QString str;
-        str.setNum(x, 'f', 3);
-        return str;
-    }
+    const uint32_t paid = value.toUInt();
+    return paid ? QString("$%1").arg(paid) : QString("--");
+}
+
+template <FBBPlayer::HittingStats STAT>
+static QVariant HittingStat(const FBBDraftBoardModel&, const FBBPlayer& player)
+{
+    return player.Hitting(STAT);
+}
+
+template <FBBPlayer::PitchingStats STAT>
+static QVariant PitchingStat(const FBBDraftBoardModel&, const FBBPlayer& player)
+{
+    return player.Pitching(STAT);
+}
+
+template <FBBPlayer::HittingCategory CATEGORY>
+static QVariant ZHitting(const FBBDraftBoardModel&, const FBBPlayer& player)
+{
+    return player.ZHitting(CATEGORY);
+}
 
-    return x;
+template <FBBPlayer::PitchingCategory CATEGORY>
+static QVariant ZPitching(const FBBDraftBoardModel&, const FBBPlayer& player)
+{
+    return player.ZPitching(CATEGORY);
 }
 
+// Indexed by COLUMN (entries in the same order)
+const FBBDraftBoardModel::Column FBBDraftBoardModel::s_columns[] =
+{
+    // COLUMN_ID
+    { "ID", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Id();
+    }, nullptr, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_RANK
+    { "#", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Rank();
+    }, nullptr, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_OWNER
+    { "Owner", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        if (!player.Owner()) {
+            return "--";
+        }
+        return fbbApp->Settings()->owners[player.Owner()]->abbreviation;
+    }, nullptr, nullptr, k_AlignText, 7 },
+
+    // COLUMN_PAID
+    { "Paid", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Paid();
+    }, FormatPaid, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_NAME
+    { "Name", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Name();
+    }, nullptr, nullptr, k_AlignText, 25 },
+
+    // COLUMN_TEAM
+    { "Team", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return FBBTeamToString(player.Team());
+    }, nullptr, nullptr, k_AlignText, 6 },
+
+    // COLUMN_AGE
+    { "Age", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Age();
+    }, nullptr, nullptr, k_AlignNumber, 6 },
+
+    // COLUMN_EXPERIENCE
+    { "Exp.", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Experience();
+    }, nullptr, nullptr, k_AlignNumber, 6 },
+
+    // COLUMN_POSITION
+    { "Pos.", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return FBBPositionMaskToString(player.EligablePositions(), false);
+    }, nullptr, nullptr, k_AlignText, 13 },
+
+    // COLUMN_AB, COLUMN_H
+    { "AB", Column::APPLIES_HITTERS, HittingStat<FBBPlayer::HITTING_STAT_AB>, nullptr, nullptr, k_AlignNumber, 7 },
+    { "H",  Column::APPLIES_HITTERS, HittingStat<FBBPlayer::HITTING_STAT_H>,  nullptr, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_AVG ... COLUMN_SB
+    { "AVG", Column::APPLIES_HITTERS, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.AVG();
+    }, FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "HR",  Column::APPLIES_HITTERS, HittingStat<FBBPlayer::HITTING_STAT_HR>,  nullptr, nullptr, k_AlignNumber, 7 },
+    { "R",   Column::APPLIES_HITTERS, HittingStat<FBBPlayer::HITTING_STAT_R>,   nullptr, nullptr, k_AlignNumber, 7 },
+    { "RBI", Column::APPLIES_HITTERS, HittingStat<FBBPlayer::HITTING_STAT_RBI>, nullptr, nullptr, k_AlignNumber, 7 },
+    { "SB",  Column::APPLIES_HITTERS, HittingStat<FBBPlayer::HITTING_STAT_SB>,  nullptr, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_Z_AVG ... COLUMN_Z_SB
+    { "zAVG", Column::APPLIES_HITTERS, ZHitting<FBBPlayer::HITTING_CATEGORY_AVG>, FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zHR",  Column::APPLIES_HITTERS, ZHitting<FBBPlayer::HITTING_CATEGORY_HR>,  FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zR",   Column::APPLIES_HITTERS, ZHitting<FBBPlayer::HITTING_CATEGORY_R>,   FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zRBI", Column::APPLIES_HITTERS, ZHitting<FBBPlayer::HITTING_CATEGORY_RBI>, FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zSB",  Column::APPLIES_HITTERS, ZHitting<FBBPlayer::HITTING_CATEGORY_SB>,  FormatFloat, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_IP ... COLUMN_ER
+    { "IP", Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_IP>, nullptr, nullptr, k_AlignNumber, 7 },
+    { "HA", Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_H>,  nullptr, nullptr, k_AlignNumber, 7 },
+    { "BB", Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_BB>, nullptr, nullptr, k_AlignNumber, 7 },
+    { "ER", Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_ER>, nullptr, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_SO ... COLUMN_SV
+    { "KO",  Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_SO>, nullptr, nullptr, k_AlignNumber, 7 },
+    { "ERA", Column::APPLIES_PITCHERS, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.ERA();
+    }, FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "WHIP", Column::APPLIES_PITCHERS, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.WHIP();
+    }, FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "W",   Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_W>,  nullptr, nullptr, k_AlignNumber, 7 },
+    { "SV",  Column::APPLIES_PITCHERS, PitchingStat<FBBPlayer::PITCHING_STAT_SV>, nullptr, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_Z_SO ... COLUMN_Z_SV
+    { "zKO",   Column::APPLIES_PITCHERS, ZPitching<FBBPlayer::PITCHING_CATEGORY_SO>,   FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zERA",  Column::APPLIES_PITCHERS, ZPitching<FBBPlayer::PITCHING_CATEGORY_ERA>,  FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zWHIP", Column::APPLIES_PITCHERS, ZPitching<FBBPlayer::PITCHING_CATEGORY_WHIP>, FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zW",    Column::APPLIES_PITCHERS, ZPitching<FBBPlayer::PITCHING_CATEGORY_W>,    FormatFloat, nullptr, k_AlignNumber, 7 },
+    { "zSV",   Column::APPLIES_PITCHERS, ZPitching<FBBPlayer::PITCHING_CATEGORY_SV>,   FormatFloat, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_Z (headerData names it after the engine)
+    { "zScore", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.ZScore();
+    }, FormatFloat, nullptr, k_AlignNumber, 10 },
+
+    // COLUMN_ESTIMATE
+    { "$", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Estimate();
+    }, FormatFloat, nullptr, k_AlignNumber, 10 },
+
+    // COLUMN_INFLATED (drafted players keep their pre-draft value)
+    { "Infl $", Column::APPLIES_ALL, [](const FBBDraftBoardModel& model, const FBBPlayer& player) -> QVariant {
+        return player.Owner() != 0 ? player.BaseValue() : player.BaseValue() * model.m_inflation.Factor();
+    }, FormatFloat, nullptr, k_AlignNumber, 10 },
+
+    // COLUMN_MARKET
+    { "Mkt $", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.MarketPrice();
+    }, FormatFloat, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return QString("$%1 - $%2 (80%)").arg(int(player.MarketLow())).arg(int(player.MarketHigh()));
+    }, k_AlignNumber, 10 },
+
+    // COLUMN_AVAILABLE
+    { "Avail", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer& player) -> QVariant {
+        return player.Available();
+    }, FormatFloat, nullptr, k_AlignNumber, 7 },
+
+    // COLUMN_COMMENT
+    { "Comment", Column::APPLIES_ALL, [](const FBBDraftBoardModel&, const FBBPlayer&) -> QVariant {
+        return "Comment";
+    }, nullptr, nullptr, k_AlignText, 0 },
+};
+
 FBBDraftBoardModel::FBBDraftBoardModel(QObject* parent)
     : QAbstractTableModel(parent)
 {
     m_font = QFont("Consolas", 9);
     m_draftedFont = m_font;
     m_draftedFont.setItalic(true);
+
+    m_pSimulator = new FBBAuctionSimulator(this);
+    connect(m_pSimulator, &FBBAuctionSimulator::Progress, this, &FBBDraftBoardModel::OnSimulationProgress);
+
+    // Invalidate cached cells and sort ranks along with the views (connected
+    // first, so before any view repaints or proxy re-sorts)
+    m_vecSortRanks.resize(COLUMN_COUNT);
+    auto ResetCaches = [=]() {
+        m_renderCache.Reset(m_vecPlayers.size(), COLUMN_COUNT);
+        for (std::vector<uint32_t>& vecRanks : m_vecSortRanks) {
+            vecRanks.clear();
+        }
+    };
+    connect(this, &QAbstractItemModel::modelReset, this, ResetCaches);
+    connect(this, &QAbstractItemModel::rowsInserted, this, ResetCaches);
+    connect(this, &QAbstractItemModel::dataChanged, this, [=](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+        if (!topLeft.isValid() || !bottomRight.isValid()) {
+            return;
+        }
+        if (topLeft.row() == 0 && bottomRight.row() == rowCount() - 1) {
+            m_renderCache.InvalidateColumns(topLeft.column(), bottomRight.column());
+        } else {
+            m_renderCache.InvalidateRows(topLeft.row(), bottomRight.row());
+        }
+        for (int column = topLeft.column(); column <= bottomRight.column(); column++) {
+            m_vecSortRanks[column].clear();
+        }
+    });
 }
 
-void FBBDraftBoardModel::Reset(const std::vector<FBBPlayer*>& vecPlayers)
+void FBBDraftBoardModel::Reset(FBBPlayerStore* pStore)
 {
+    FBB_TRACE_SCOPE("FBBDraftBoardModel::Reset");
+
     emit beginResetModel();
-    m_vecPlayers = vecPlayers;
-    CalculateHittingZScores();
-    CalculatePitchingZScores();
+    m_pStore = pStore;
+    m_vecPlayers = pStore ? pStore->Players() : std::vector<FBBPlayer*>();
+    m_vecHittingPool.clear();
+    m_vecPitchingPool.clear();
+    CalculateZScores();
+    ResetInflation(true);
+    Simulate();
     emit endResetModel();
 }
 
@@ -68,7 +265,7 @@ std::vector<FBBPlayer*> FBBDraftBoardModel::GetValidHitters()
 {
     std::vector<FBBPlayer*> ret;
     for (FBBPlayer* pPlayer : m_vecPlayers) {
-        if (pPlayer->type == FBBPlayer::PLAYER_TYPE_HITTER) {
+        if (pPlayer->Type() == FBBPlayer::PLAYER_TYPE_HITTER) {
             if (pPlayer->IsValidUnderCurrentSettings()) {
                 ret.push_back(pPlayer);
             }
@@ -81,7 +278,7 @@ std::vector<FBBPlayer*> FBBDraftBoardModel::GetValidPitchers()
 {
     std::vector<FBBPlayer*> ret;
     for (FBBPlayer* pPlayer : m_vecPlayers) {
-        if (pPlayer->type == FBBPlayer::PLAYER_TYPE_PITCHER) {
+        if (pPlayer->Type() == FBBPlayer::PLAYER_TYPE_PITCHER) {
             if (pPlayer->IsValidUnderCurrentSettings()) {
                 ret.push_back(pPlayer);
             }
@@ -95,13 +292,14 @@ QJsonObject FBBDraftBoardModel::ToJson() const
     QJsonObject jsonArray;
     for (const FBBPlayer* pPlayer : m_vecPlayers)
     {
-        if (pPlayer->draftInfo.owner != -1)
+        if (pPlayer->Owner() != -1)
         {
             QVariantMap vm;
-            vm["owner"] = pPlayer->draftInfo.owner;
-            vm["paid"] = pPlayer->draftInfo.paid;
-            vm["position"] = pPlayer->draftInfo.position;
-            jsonArray[pPlayer->id] = (QJsonObject::fromVariantMap(vm));
+            vm["owner"] = pPlayer->Owner();
+            vm["paid"] = pPlayer->Paid();
+            vm["position"] = pPlayer->DraftPosition();
+            vm["type"] = pPlayer->Type();
+            jsonArray[pPlayer->Id()] = (QJsonObject::fromVariantMap(vm));
         }
     }
 
@@ -110,6 +308,93 @@ QJsonObject FBBDraftBoardModel::ToJson() const
     return json;
 }
 
+void FBBDraftBoardModel::FromJson(const QJsonObject& json)
+{
+    const FBBPlayerRegistry& registry = FBBProjectionService::Instance().Registry();
+    const auto& owners = fbbApp->Settings()->owners;
+
+    // The file replaces the current draft rather than adding to it
+    if (m_pStore) {
+        for (FBBPlayer::PlayerType type : { FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::PLAYER_TYPE_PITCHER }) {
+            FBBPlayerColumns& columns = m_pStore->Columns(type);
+            std::fill(columns.owner.begin(), columns.owner.end(), FBBOwnerId(0));
+            std::fill(columns.paid.begin(), columns.paid.end(), 0u);
+            std::fill(columns.position.begin(), columns.position.end(), FBB_POSITION_UNKNOWN);
+            std::fill(columns.estimate.begin(), columns.estimate.end(), 0.f);
+        }
+    }
+
+    const QJsonObject drafted = json["drafted"].toObject();
+    for (auto itr = drafted.constBegin(); itr != drafted.constEnd(); ++itr) {
+
+        // Skip undrafted players and owners that no longer exist
+        const QJsonObject entry = itr.value().toObject();
+        const FBBOwnerId owner = entry["owner"].toVariant().toULongLong();
+        if (!owner || owners.find(owner) == owners.end()) {
+            continue;
+        }
+
+        // Resolve the saved id (older saves don't record the player type)
+        const FBBPlayerHandle handle = registry.Find(itr.key());
+        const FBBPlayer::PlayerType type = FBBPlayer::PlayerType(entry["type"].toInt(FBBPlayer::PLAYER_TYPE_HITTER));
+        FBBPlayer* pPlayer = registry.Player(handle, type);
+        if (!pPlayer) {
+            pPlayer = registry.Player(handle, type == FBBPlayer::PLAYER_TYPE_HITTER ? FBBPlayer::PLAYER_TYPE_PITCHER : FBBPlayer::PLAYER_TYPE_HITTER);
+        }
+        if (!pPlayer) {
+            continue;
+        }
+
+        pPlayer->Owner() = owner;
+        pPlayer->Paid() = uint32_t(entry["paid"].toInt());
+        pPlayer->DraftPosition() = FBBPositionBits(entry["position"].toInt());
+    }
+
+    // Reprice the remaining pool
+    ResetValuation(FBBPlayer::PLAYER_TYPE_HITTER, GetValidRows(FBBPlayer::PLAYER_TYPE_HITTER));
+    ResetValuation(FBBPlayer::PLAYER_TYPE_PITCHER, GetValidRows(FBBPlayer::PLAYER_TYPE_PITCHER));
+    ResetInflation(false);
+    Simulate();
+
+    emit dataChanged(index(0, 0), index(rowCount() - 1, COLUMN_COUNT - 1));
+    emit DraftLoaded();
+}
+
+QByteArray FBBDraftBoardModel::ToCSV() const
+{
+    // Typed values rather than display text, so spreadsheets get numbers
+    QByteArray csv;
+    auto AppendField = [&](int column, const QString& field) {
+        if (column > 0) {
+            csv += ',';
+        }
+        if (field.contains(',') || field.contains('"')) {
+            QString quoted = field;
+            quoted.replace("\"", "\"\"");
+            csv += '"' + quoted.toUtf8() + '"';
+        } else {
+            csv += field.toUtf8();
+        }
+    };
+
+    for (int column = 0; column < COLUMN_COUNT; column++) {
+        AppendField(column, headerData(column, Qt::Horizontal, Qt::DisplayRole).toString());
+    }
+    csv += '\n';
+
+    for (const FBBPlayer* pPlayer : m_vecPlayers) {
+        if (!pPlayer->IsValidUnderCurrentSettings()) {
+            continue;
+        }
+        for (int column = 0; column < COLUMN_COUNT; column++) {
+            AppendField(column, ColumnValue(pPlayer, column).toString());
+        }
+        csv += '\n';
+    }
+
+    return csv;
+}
+
 int FBBDraftBoardModel::rowCount(const QModelIndex& parent) const
 {
     return PlayerCount();
@@ -126,6 +411,106 @@ Qt::ItemFlags FBBDraftBoardModel::flags(const QModelIndex& index) const
     return flags;
 }
 
+const FBBDraftBoardModel::Column& FBBDraftBoardModel::ColumnInfo(int column)
+{
+    static_assert(sizeof(s_columns) / sizeof(s_columns[0]) == COLUMN_COUNT, "one entry per column");
+    return s_columns[column];
+}
+
+QVariant FBBDraftBoardModel::ColumnValue(const FBBPlayer* pPlayer, int column) const
+{
+    const Column& info = s_columns[column];
+    switch (info.applies)
+    {
+    case Column::APPLIES_ALL:
+        break;
+    case Column::APPLIES_HITTERS:
+        if (pPlayer->Type() != FBBPlayer::PLAYER_TYPE_HITTER) {
+            return QVariant();
+        }
+        break;
+    case Column::APPLIES_PITCHERS:
+        if (pPlayer->Type() != FBBPlayer::PLAYER_TYPE_PITCHER) {
+            return QVariant();
+        }
+        break;
+    }
+
+    return info.value(*this, *pPlayer);
+}
+
+const std::vector<uint32_t>& FBBDraftBoardModel::SortRanks(int column) const
+{
+    std::vector<uint32_t>& vecRanks = m_vecSortRanks[column];
+    if (vecRanks.size() == m_vecPlayers.size()) {
+        return vecRanks;
+    }
+
+    FBB_TRACE_SCOPE("FBBDraftBoardModel::SortRanks");
+
+    // Typed keys, read once per row. A column holds either text or numbers;
+    // rows it doesn't apply to sort first.
+    const size_t count = m_vecPlayers.size();
+    std::vector<bool> vecValid(count, false);
+    std::vector<double> vecNumbers;
+    std::vector<QString> vecTexts;
+    for (size_t row = 0; row < count; row++) {
+        const QVariant value = ColumnValue(m_vecPlayers[row], column);
+        if (!value.isValid()) {
+            continue;
+        }
+        vecValid[row] = true;
+        if (value.userType() == QMetaType::QString) {
+            vecTexts.resize(count);
+            vecTexts[row] = value.toString();
+        } else {
+            vecNumbers.resize(count);
+            vecNumbers[row] = value.toDouble();
+        }
+    }
+
+    const bool isText = !vecTexts.empty();
+    auto Less = [&](uint32_t lhs, uint32_t rhs) -> bool {
+        if (vecValid[lhs] != vecValid[rhs]) {
+            return vecValid[rhs];
+        }
+        if (!vecValid[lhs]) {
+            return false;
+        }
+        return isText ? vecTexts[lhs] < vecTexts[rhs] : vecNumbers[lhs] < vecNumbers[rhs];
+    };
+
+    std::vector<uint32_t> vecOrder(count);
+    std::iota(vecOrder.begin(), vecOrder.end(), 0);
+    std::sort(vecOrder.begin(), vecOrder.end(), Less);
+
+    // Equal keys share a rank, so the proxy's stable sort keeps their order
+    vecRanks.resize(count);
+    uint32_t rank = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && Less(vecOrder[i - 1], vecOrder[i])) {
+            rank++;
+        }
+        vecRanks[vecOrder[i]] = rank;
+    }
+
+    return vecRanks;
+}
+
+QVariant FBBDraftBoardModel::CellData(const FBBPlayer* pPlayer, int column, int role) const
+{
+    const Column& info = s_columns[column];
+    if (role == Qt::ToolTipRole && info.toolTip) {
+        return info.toolTip(*this, *pPlayer);
+    }
+
+    const QVariant value = ColumnValue(pPlayer, column);
+    if (role == RawDataRole || !info.format || !value.isValid()) {
+        return value;
+    }
+    return info.format(value);
+}
+
 QVariant FBBDraftBoardModel::data(const QModelIndex& index, int role) const
 {
     // Get player
@@ -136,192 +521,27 @@ QVariant FBBDraftBoardModel::data(const QModelIndex& index, int role) const
         return QVariant();
     }
 
-    const bool isHitter = pPlayer->type == FBBPlayer::PLAYER_TYPE_HITTER;
-    const bool isPitcher = pPlayer->type == FBBPlayer::PLAYER_TYPE_PITCHER;
-
-    if (role == Qt::DisplayRole || role == Qt::ToolTipRole || role == RawDataRole) {
-
-        switch (index.column())
-        {
-        case COLUMN_ID:
-            return pPlayer->id;
-        case COLUMN_RANK:
-            return pPlayer->calculations.rank;
-        case COLUMN_OWNER: {
-            if (!pPlayer->draftInfo.owner) {
-                return "--";
-            }
-            return fbbApp->Settings()->owners[pPlayer->draftInfo.owner]->abbreviation;
-        } break;
-        case COLUMN_PAID:
-            return pPlayer->draftInfo.paid ? QString("$%1").arg(pPlayer->draftInfo.paid) : "--";
-        case COLUMN_NAME:
-            return pPlayer->name;
-        case COLUMN_TEAM:
-            return FBBTeamToString(pPlayer->team);
-        case COLUMN_AGE:
-            return pPlayer->age;
-        case COLUMN_EXPERIENCE:
-            return pPlayer->experience;
-        case COLUMN_POSITION:
-        {
-            return FBBPositionMaskToString(pPlayer->EligablePositions(), false);
-        }
-        case COLUMN_AB:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.AB, role);
-            }
-        case COLUMN_H:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.H, role);
-            }
-        case COLUMN_AVG:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.AVG(), role);
-            }
-            break;
-        case COLUMN_Z_AVG:
-            if (isHitter) {
-                return ToQVariant(pPlayer->calculations.zHitting.AVG, role);
-            }
-            break;
-        case COLUMN_HR:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.HR, role);
-            }
-            break;
-        case COLUMN_Z_HR:
-            if (isHitter) {
-                return ToQVariant(pPlayer->calculations.zHitting.HR, role);
-            }
-            break;
-        case COLUMN_R:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.R, role);
-            }
-            break;
-        case COLUMN_Z_R:
-            if (isHitter) {
-                return ToQVariant(pPlayer->calculations.zHitting.R, role);
-            }
-            break;
-        case COLUMN_RBI:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.RBI, role);
-            }
-            break;
-        case COLUMN_Z_RBI:
-            if (isHitter) {
-                return ToQVariant(pPlayer->calculations.zHitting.RBI, role);
-            }
-            break;
-        case COLUMN_SB:
-            if (isHitter) {
-                return ToQVariant(pPlayer->projection.hitting.SB, role);
-            }
-            break;
-        case COLUMN_Z_SB:
-            if (isHitter) {
-                return ToQVariant(pPlayer->calculations.zHitting.SB, role);
-            }
-            break;
-        case COLUMN_IP:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.IP, role);
-            }
-            break;
-        case COLUMN_HA:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.H, role);
-            }
-            break;
-        case COLUMN_BB:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.BB, role);
-            }
-            break;
-        case COLUMN_ER:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.ER, role);
-            }
-            break;
-        case COLUMN_SO:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.SO, role);
-            }
-            break;
-        case COLUMN_Z_SO:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->calculations.zPitching.SO, role);
-            }
-            break;
-        case COLUMN_ERA:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.ERA(), role);
-            }
-            break;
-        case COLUMN_Z_ERA:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->calculations.zPitching.ERA, role);
-            }
-            break;
-        case COLUMN_WHIP:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.WHIP(), role);
-            }
-            break;
-        case COLUMN_Z_WHIP:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->calculations.zPitching.WHIP, role);
-            }
-            break;
-        case COLUMN_W:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.W, role);
-            }
-            break;
-        case COLUMN_Z_W:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->calculations.zPitching.W, role);
-            }
-            break;
-        case COLUMN_SV:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->projection.pitching.SV, role);
-            }
-            break;
-        case COLUMN_Z_SV:
-            if (isPitcher) {
-                return ToQVariant(pPlayer->calculations.zPitching.SV, role);
-            }
-            break;
-        case COLUMN_ESTIMATE:
-            return ToQVariant(pPlayer->calculations.estimate, role);
-        case COLUMN_Z: {
-            return ToQVariant(pPlayer->calculations.zScore, role);
-        } break;
-        case COLUMN_COMMENT:
-            return "Comment";
+    // Formatted values are cached for painting
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+        const FBBRenderCache::Slot slot = role == Qt::DisplayRole ? FBBRenderCache::SLOT_DISPLAY : FBBRenderCache::SLOT_TOOL_TIP;
+        if (const QVariant* pCached = m_renderCache.Find(index.row(), index.column(), slot)) {
+            return *pCached;
         }
+        const QVariant value = CellData(pPlayer, index.column(), role);
+        m_renderCache.Store(index.row(), index.column(), slot, value);
+        return value;
     }
 
-    if (role == Qt::TextAlignmentRole) {
+    if (role == RawDataRole) {
+        return ColumnValue(pPlayer, index.column());
+    }
 
-        switch (index.column()) {
-        
-        case COLUMN_NAME:
-        case COLUMN_TEAM:
-        case COLUMN_POSITION:
-        case COLUMN_OWNER:
-        case COLUMN_COMMENT:
-            return int(Qt::AlignLeft| Qt::AlignVCenter);
-        default:
-            return int(Qt::AlignRight | Qt::AlignVCenter);
-        }
+    if (role == Qt::TextAlignmentRole) {
+        return s_columns[index.column()].alignment;
     }
 
     if (role == Qt::FontRole) {
-        if (pPlayer->draftInfo.owner != 0) {
+        if (pPlayer->Owner() != 0) {
             return m_draftedFont;
         } else {
             return m_font;
@@ -329,7 +549,7 @@ QVariant FBBDraftBoardModel::data(const QModelIndex& index, int role) const
     }
 
     if (role == Qt::ForegroundRole) {
-        if (pPlayer->draftInfo.owner != 0) {
+        if (pPlayer->Owner() != 0) {
             return QColor(Qt::gray);
         }
     }
@@ -343,89 +563,19 @@ QVariant FBBDraftBoardModel::headerData(int section, Qt::Orientation orientation
         return m_font;
     }
 
-    if (orientation == Qt::Horizontal) {
+    if (orientation == Qt::Horizontal && section >= 0 && section < COLUMN_COUNT) {
 
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
 
-            switch (section)
-            {
-            case COLUMN_RANK:
-                return "#";
-            case COLUMN_ID:
-                return "ID";
-            case COLUMN_OWNER:
-                return "Owner";
-            case COLUMN_PAID:
-                return "Paid";
-            case COLUMN_NAME:
-                return "Name";
-            case COLUMN_TEAM:
-                return "Team";
-            case COLUMN_AGE:
-                return "Age";
-            case COLUMN_EXPERIENCE:
-                return "Exp.";
-            case COLUMN_POSITION:
-                return "Pos.";
-            case COLUMN_AB:
-                return "AB";
-            case COLUMN_H:
-                return "H";
-            case COLUMN_AVG:
-                return "AVG";
-            case COLUMN_HR:
-                return "HR";
-            case COLUMN_R:
-                return "R";
-            case COLUMN_RBI:
-                return "RBI";
-            case COLUMN_SB:
-                return "SB";
-            case COLUMN_Z_AVG:
-                return "zAVG";
-            case COLUMN_Z_HR:
-                return "zHR";
-            case COLUMN_Z_R:
-                return "zR";
-            case COLUMN_Z_RBI:
-                return "zRBI";
-            case COLUMN_Z_SB:
-                return "zSB";
-            case COLUMN_IP:
-                return "IP";
-            case COLUMN_HA:
-                return "HA";
-            case COLUMN_BB:
-                return "BB";
-            case COLUMN_ER:
-                return "ER";
-            case COLUMN_SO:
-                return "KO";
-            case COLUMN_ERA:
-                return "ERA";
-            case COLUMN_WHIP:
-                return "WHIP";
-            case COLUMN_W:
-                return "W";
-            case COLUMN_SV:
-                return "SV";
-            case COLUMN_Z_SO:
-                return "zKO";
-            case COLUMN_Z_ERA:
-                return "zERA";
-            case COLUMN_Z_WHIP:
-                return "zWHIP";
-            case COLUMN_Z_W:
-                return "zW";
-            case COLUMN_Z_SV:
-                return "zSV";
-            case COLUMN_ESTIMATE:
-                return "$";
-            case COLUMN_Z:
-                return "zScore";
-            case COLUMN_COMMENT:
-                return "Comment";
+            // Labels that follow the league or the draft
+            if (section == COLUMN_Z) {
+                return fbbApp->Settings()->projections.engine == FBBLeaugeSettings::Projections::Engine::SGP ? "SGP" : "zScore";
             }
+            if (section == COLUMN_INFLATED && role == Qt::ToolTipRole) {
+                return QString("Pre-draft value x inflation (%1)").arg(m_inflation.Factor(), 0, 'f', 3);
+            }
+
+            return s_columns[section].header;
         }
     }
 
@@ -434,329 +584,360 @@ QVariant FBBDraftBoardModel::headerData(int section, Qt::Orientation orientation
 
 void FBBDraftBoardModel::CalculateZScores()
 {
-    CalculateHittingZScores();
-    CalculatePitchingZScores();
+    CalculateZScores(FBBPlayer::PLAYER_TYPE_HITTER);
+    CalculateZScores(FBBPlayer::PLAYER_TYPE_PITCHER);
 }
 
-void FBBDraftBoardModel::CalculateHittingZScores()
+std::vector<uint32_t> FBBDraftBoardModel::GetValidRows(FBBPlayer::PlayerType type) const
 {
-    std::vector<FBBPlayer*> vecHitters = GetValidHitters();
+    std::vector<uint32_t> ret;
+    if (!m_pStore) {
+        return ret;
+    }
 
-    struct PerHitting
-    {
-        double PA = 0;
-        double AB = 0;
-        double H = 0;
-        double _2B = 0;
-        double _3B = 0;
-        double HR = 0;
-        double R = 0;
-        double RBI = 0;
-        double BB = 0;
-        double SO = 0;
-        double HBP = 0;
-        double SB = 0;
-        double CS = 0;
-        double AVG = 0;
-    };
+    const uint32_t count = m_pStore->Count(type);
+    for (uint32_t row = 0; row < count; row++) {
+        if (m_pStore->Player(type, row)->IsValidUnderCurrentSettings()) {
+            ret.push_back(row);
+        }
+    }
+    return ret;
+}
 
-    PerHitting sumHitting;
-    for (FBBPlayer* pHitter : vecHitters) {
-        sumHitting.PA += pHitter->projection.hitting.PA;
-        sumHitting.AB += pHitter->projection.hitting.AB;
-        sumHitting.H += pHitter->projection.hitting.H;
-        sumHitting._2B += pHitter->projection.hitting._2B;
-        sumHitting._3B += pHitter->projection.hitting._3B;
-        sumHitting.HR += pHitter->projection.hitting.HR;
-        sumHitting.R += pHitter->projection.hitting.R;
-        sumHitting.RBI += pHitter->projection.hitting.RBI;
-        sumHitting.BB += pHitter->projection.hitting.BB;
-        sumHitting.SO += pHitter->projection.hitting.SO;
-        sumHitting.HBP += pHitter->projection.hitting.HBP;
-        sumHitting.SB += pHitter->projection.hitting.SB;
-        sumHitting.CS += pHitter->projection.hitting.CS;
-    }
-
-    PerHitting avgHitting;
-    avgHitting.PA = sumHitting.PA / vecHitters.size();
-    avgHitting.AB = sumHitting.AB / vecHitters.size();
-    avgHitting.H = sumHitting.H / vecHitters.size();
-    avgHitting._2B = sumHitting._2B / vecHitters.size();
-    avgHitting._3B = sumHitting._3B / vecHitters.size();
-    avgHitting.HR = sumHitting.HR / vecHitters.size();
-    avgHitting.R = sumHitting.R / vecHitters.size();
-    avgHitting.RBI = sumHitting.RBI / vecHitters.size();
-    avgHitting.BB = sumHitting.BB / vecHitters.size();
-    avgHitting.SO = sumHitting.SO / vecHitters.size();
-    avgHitting.HBP = sumHitting.HBP / vecHitters.size();
-    avgHitting.SB = sumHitting.SB / vecHitters.size();
-    avgHitting.CS = sumHitting.CS / vecHitters.size();
-    avgHitting.AVG = sumHitting.H / sumHitting.AB;
-
-    PerHitting stddevHitting;
-    for (FBBPlayer* pHitter : vecHitters) {
-        stddevHitting.PA += std::pow(pHitter->projection.hitting.PA - avgHitting.PA, 2.0);
-        stddevHitting.AB += std::pow(pHitter->projection.hitting.AB - avgHitting.AB, 2.0);
-        stddevHitting.H += std::pow(pHitter->projection.hitting.H - avgHitting.H, 2.0);
-        stddevHitting._2B += std::pow(pHitter->projection.hitting._2B - avgHitting._2B, 2.0);
-        stddevHitting._3B += std::pow(pHitter->projection.hitting._3B - avgHitting._3B, 2.0);
-        stddevHitting.HR += std::pow(pHitter->projection.hitting.HR - avgHitting.HR, 2.0);
-        stddevHitting.R += std::pow(pHitter->projection.hitting.R - avgHitting.R, 2.0);
-        stddevHitting.RBI += std::pow(pHitter->projection.hitting.RBI - avgHitting.RBI, 2.0);
-        stddevHitting.BB += std::pow(pHitter->projection.hitting.BB - avgHitting.BB, 2.0);
-        stddevHitting.SO += std::pow(pHitter->projection.hitting.SO - avgHitting.SO, 2.0);
-        stddevHitting.HBP += std::pow(pHitter->projection.hitting.HBP - avgHitting.HBP, 2.0);
-        stddevHitting.SB += std::pow(pHitter->projection.hitting.SB - avgHitting.SB, 2.0);
-        stddevHitting.CS += std::pow(pHitter->projection.hitting.CS - avgHitting.CS, 2.0);
-        stddevHitting.AVG += std::pow(pHitter->projection.hitting.AVG() - avgHitting.AVG, 2.0);
-    }
-
-    stddevHitting.PA = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.PA);
-    stddevHitting.AB = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.AB);
-    stddevHitting.H = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.H);
-    stddevHitting._2B = std::sqrt(1. / double(vecHitters.size()) * stddevHitting._2B);
-    stddevHitting._3B = std::sqrt(1. / double(vecHitters.size()) * stddevHitting._3B);
-    stddevHitting.HR = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.HR);
-    stddevHitting.R = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.R);
-    stddevHitting.RBI = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.RBI);
-    stddevHitting.BB = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.BB);
-    stddevHitting.SO = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.SO);
-    stddevHitting.HBP = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.HBP);
-    stddevHitting.SB = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.SB);
-    stddevHitting.CS = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.CS);
-    stddevHitting.AVG = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.AVG);
-
-    for (FBBPlayer* pHitter : vecHitters) {
-        pHitter->calculations.zHitting.HR = (pHitter->projection.hitting.HR - avgHitting.HR) / stddevHitting.HR;
-        pHitter->calculations.zHitting.R = (pHitter->projection.hitting.R - avgHitting.R) / stddevHitting.R;
-        pHitter->calculations.zHitting.RBI = (pHitter->projection.hitting.RBI - avgHitting.RBI) / stddevHitting.RBI;
-        pHitter->calculations.zHitting.SB = (pHitter->projection.hitting.SB - avgHitting.SB) / stddevHitting.SB;
-        pHitter->calculations.zHitting.AVG = (pHitter->projection.hitting.AVG() - avgHitting.AVG) / stddevHitting.AVG;
-    }
-
-    sumHitting.AVG = 0;
-    for (FBBPlayer* pHitter : vecHitters) {
-        pHitter->calculations.zHitting.AVG *= pHitter->projection.hitting.AB;
-        sumHitting.AVG += pHitter->calculations.zHitting.AVG;
-    }
-
-    stddevHitting.AVG = 0;
-    for (FBBPlayer* pHitter : vecHitters) {
-        stddevHitting.AVG += std::pow(pHitter->calculations.zHitting.AVG - avgHitting.AVG, 2.0);
-    }
-    stddevHitting.AVG = std::sqrt(1. / double(vecHitters.size()) * stddevHitting.AVG);
-
-    for (FBBPlayer* pHitter : vecHitters) {
-        pHitter->calculations.zHitting.AVG = (pHitter->calculations.zHitting.AVG - avgHitting.AVG) / stddevHitting.AVG;
-    }
-
-    for (FBBPlayer* pHitter : vecHitters) {
-        pHitter->calculations.zScore = 0;
-        if (fbbApp->Settings()->categories.hitting.HR) {
-            pHitter->calculations.zScore += pHitter->calculations.zHitting.HR;
-        }
-        if (fbbApp->Settings()->categories.hitting.R) {
-            pHitter->calculations.zScore += pHitter->calculations.zHitting.R;
-        }
-        if (fbbApp->Settings()->categories.hitting.RBI) {
-            pHitter->calculations.zScore += pHitter->calculations.zHitting.RBI;
-        }
-        if (fbbApp->Settings()->categories.hitting.SB) {
-            pHitter->calculations.zScore += pHitter->calculations.zHitting.SB;
-        }
-        if (fbbApp->Settings()->categories.hitting.AVG) {
-            pHitter->calculations.zScore += pHitter->calculations.zHitting.AVG;
-        }
-    }
-
-    // Sort by zScore
-    std::sort(vecHitters.begin(), vecHitters.end(), [](const FBBPlayer* pLHS, const FBBPlayer* pRHS) {
-        return pLHS->calculations.zScore > pRHS->calculations.zScore;
-    });
+FBBValuation& FBBDraftBoardModel::Valuation(FBBPlayer::PlayerType type)
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? m_hittingValuation : m_pitchingValuation;
+}
+
+std::vector<uint32_t>& FBBDraftBoardModel::DraftablePool(FBBPlayer::PlayerType type)
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? m_vecHittingPool : m_vecPitchingPool;
+}
+
+int FBBDraftBoardModel::ModelRow(const FBBPlayer* pPlayer) const
+{
+    // Hitters come first
+    const bool isPitcher = pPlayer->Type() == FBBPlayer::PLAYER_TYPE_PITCHER;
+    return int(pPlayer->Row() + (isPitcher ? m_pStore->Count(FBBPlayer::PLAYER_TYPE_HITTER) : 0));
+}
 
-    // Get replacement player
-    const size_t numDraftedHitters = fbbApp->Settings()->SumHitters() * fbbApp->Settings()->owners.size();
-    if (numDraftedHitters >= vecHitters.size()) {
+void FBBDraftBoardModel::CalculateZScores(FBBPlayer::PlayerType type)
+{
+    FBB_TRACE_SCOPE("FBBDraftBoardModel::CalculateZScores");
+
+    if (!m_pStore) {
         return;
     }
-    double replacementZ = vecHitters[numDraftedHitters]->calculations.zScore;
-    
-    // Normalize zScores
-    double sumZ = 0;
-    for (FBBPlayer* pHitter : vecHitters) {
-        pHitter->calculations.zScore -= replacementZ;
-        if (pHitter->calculations.zScore > 0.0) {
-            sumZ += pHitter->calculations.zScore;
-        }
+
+    // Score enabled categories
+    const std::vector<uint32_t> vecRows = GetValidRows(type);
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    if (pSettings->projections.pool == FBBLeaugeSettings::Projections::Pool::Draftable) {
+        ScoreDraftablePool(type, vecRows);
+    } else {
+        DraftablePool(type).clear();
+        Score(type, vecRows, vecRows);
     }
 
     // Calculate cost estimates
-    const double totalMoney = fbbApp->Settings()->leauge.budget * fbbApp->Settings()->owners.size();
-    const double totalHittingMoney = fbbApp->Settings()->projections.hittingPitchingSplit * totalMoney;
-    const double costPerZ = totalHittingMoney / sumZ;
-    for (FBBPlayer* pHitter : vecHitters) {
-        pHitter->calculations.estimate = pHitter->calculations.zScore * costPerZ;
+    ResetValuation(type, vecRows);
+}
+
+void FBBDraftBoardModel::Score(FBBPlayer::PlayerType type, const std::vector<uint32_t>& vecRows, const std::vector<uint32_t>& vecPool)
+{
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    const std::vector<const FBBCategory*> vecCategories = FBBEnabledCategories(type, pSettings->categories);
+    FBBPlayerColumns& columns = m_pStore->Columns(type);
+
+    if (pSettings->projections.engine == FBBLeaugeSettings::Projections::Engine::SGP) {
+        const bool isHitter = type == FBBPlayer::PLAYER_TYPE_HITTER;
+        const size_t teamSize = isHitter ? pSettings->SumHitters() : pSettings->SumPitchers();
+        FBBCalculateSGP(columns, type, vecCategories, FBBSGPDenominators(type, vecCategories, pSettings->sgp), teamSize, vecRows, vecPool);
+    } else {
+        FBBCalculateZScores(columns, type, vecCategories, vecRows, vecPool);
     }
 }
 
-void FBBDraftBoardModel::CalculatePitchingZScores()
+void FBBDraftBoardModel::ScoreDraftablePool(FBBPlayer::PlayerType type, const std::vector<uint32_t>& vecRows)
 {
-    std::vector<FBBPlayer*> vecPitchers = GetValidPitchers();
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    const FBBPlayerColumns& columns = m_pStore->Columns(type);
+    const bool isHitter = type == FBBPlayer::PLAYER_TYPE_HITTER;
+    const size_t numSlots = (isHitter ? pSettings->SumHitters() : pSettings->SumPitchers()) * pSettings->owners.size();
+
+    // Start from the last pool, minus anyone who is no longer valid
+    std::vector<uint32_t>& vecPool = DraftablePool(type);
+    std::vector<uint32_t> vecNext;
+    std::set_intersection(vecPool.begin(), vecPool.end(), vecRows.begin(), vecRows.end(), std::back_inserter(vecNext));
+    vecPool.swap(vecNext);
+    if (vecPool.empty()) {
+        vecPool = vecRows;
+    }
+
+    // Score against the pool, then take drafted players plus the best
+    // undrafted ones as the next pool until it stops changing. Starting from
+    // the last answer, a pick usually settles in two or three passes. Players
+    // on the cut line can swap in and out forever, so a pool that comes back
+    // after one pass also ends the search.
+    const uint32_t MAX_ITERATIONS = 16;
+    std::vector<uint32_t> vecPrevious;
+    for (uint32_t iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+        Score(type, vecRows, vecPool);
+
+        vecNext.clear();
+        std::vector<uint32_t> vecUndrafted;
+        for (uint32_t row : vecRows) {
+            (columns.owner[row] != 0 ? vecNext : vecUndrafted).push_back(row);
+        }
 
-    struct PerPitching
-    {
-        double W = 0;
-        double L = 0;
-        double GS = 0;
-        double G = 0;
-        double SV = 0;
-        double IP = 0;
-        double H = 0;
-        double ER = 0;
-        double HR = 0;
-        double SO = 0;
-        double BB = 0;
-        double ERA = 0;
-        double WHIP = 0;
-    };
+        const size_t open = numSlots > vecNext.size() ? numSlots - vecNext.size() : 0;
+        if (open < vecUndrafted.size()) {
+            const std::vector<float>& zScore = columns.zScore;
+            std::nth_element(vecUndrafted.begin(), vecUndrafted.begin() + open, vecUndrafted.end(), [&](uint32_t lhs, uint32_t rhs) {
+                return zScore[lhs] != zScore[rhs] ? zScore[lhs] > zScore[rhs] : lhs < rhs;
+            });
+            vecUndrafted.resize(open);
+        }
+        vecNext.insert(vecNext.end(), vecUndrafted.begin(), vecUndrafted.end());
+        std::sort(vecNext.begin(), vecNext.end());
 
-    PerPitching sumPitching;
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        sumPitching.W += pPitcher->projection.pitching.W;
-        sumPitching.L += pPitcher->projection.pitching.L;
-        sumPitching.GS += pPitcher->projection.pitching.GS;
-        sumPitching.G += pPitcher->projection.pitching.G;
-        sumPitching.SV += pPitcher->projection.pitching.SV;
-        sumPitching.IP += pPitcher->projection.pitching.IP;
-        sumPitching.H += pPitcher->projection.pitching.H;
-        sumPitching.ER += pPitcher->projection.pitching.ER;
-        sumPitching.HR += pPitcher->projection.pitching.HR;
-        sumPitching.SO += pPitcher->projection.pitching.SO;
-        sumPitching.BB += pPitcher->projection.pitching.BB;
-    }
-
-    PerPitching avgPitching;
-    avgPitching.W = sumPitching.W / vecPitchers.size();
-    avgPitching.L = sumPitching.L / vecPitchers.size();
-    avgPitching.GS = sumPitching.GS / vecPitchers.size();
-    avgPitching.G = sumPitching.G / vecPitchers.size();
-    avgPitching.SV = sumPitching.SV / vecPitchers.size();
-    avgPitching.IP = sumPitching.IP / vecPitchers.size();
-    avgPitching.H = sumPitching.H / vecPitchers.size();
-    avgPitching.ER = sumPitching.ER / vecPitchers.size();
-    avgPitching.HR = sumPitching.HR / vecPitchers.size();
-    avgPitching.SO = sumPitching.SO / vecPitchers.size();
-    avgPitching.BB = sumPitching.BB / vecPitchers.size();
-    avgPitching.ERA = (9 * sumPitching.ER) / (sumPitching.IP);
-    avgPitching.WHIP = (sumPitching.BB + sumPitching.H) / sumPitching.IP;
-
-    PerPitching stddevPitching;
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        stddevPitching.W += std::pow(pPitcher->projection.pitching.W - avgPitching.W, 2.0);
-        stddevPitching.L += std::pow(pPitcher->projection.pitching.L - avgPitching.L, 2.0);
-        stddevPitching.GS += std::pow(pPitcher->projection.pitching.GS - avgPitching.GS, 2.0);
-        stddevPitching.G += std::pow(pPitcher->projection.pitching.G - avgPitching.G, 2.0);
-        stddevPitching.SV += std::pow(pPitcher->projection.pitching.SV - avgPitching.SV, 2.0);
-        stddevPitching.IP += std::pow(pPitcher->projection.pitching.IP - avgPitching.IP, 2.0);
-        stddevPitching.H += std::pow(pPitcher->projection.pitching.H - avgPitching.H, 2.0);
-        stddevPitching.ER += std::pow(pPitcher->projection.pitching.ER - avgPitching.ER, 2.0);
-        stddevPitching.HR += std::pow(pPitcher->projection.pitching.HR - avgPitching.HR, 2.0);
-        stddevPitching.SO += std::pow(pPitcher->projection.pitching.SO - avgPitching.SO, 2.0);
-        stddevPitching.BB += std::pow(pPitcher->projection.pitching.BB - avgPitching.BB, 2.0);
-        stddevPitching.ERA += std::pow(pPitcher->projection.pitching.ERA() - avgPitching.ERA, 2.0);
-        stddevPitching.WHIP += std::pow(pPitcher->projection.pitching.WHIP() - avgPitching.WHIP, 2.0);
-    }
-
-    stddevPitching.W = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.W);
-    stddevPitching.L = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.L);
-    stddevPitching.GS = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.GS);
-    stddevPitching.G = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.G);
-    stddevPitching.SV = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.SV);
-    stddevPitching.IP = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.IP);
-    stddevPitching.H = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.H);
-    stddevPitching.ER = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.ER);
-    stddevPitching.HR = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.HR);
-    stddevPitching.SO = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.SO);
-    stddevPitching.BB = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.BB);
-    stddevPitching.ERA = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.ERA);
-    stddevPitching.WHIP = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.WHIP);
-
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        pPitcher->calculations.zPitching.W = (pPitcher->projection.pitching.W - avgPitching.W) / stddevPitching.W;
-        pPitcher->calculations.zPitching.SV = (pPitcher->projection.pitching.SV - avgPitching.SV) / stddevPitching.SV;
-        pPitcher->calculations.zPitching.SO = (pPitcher->projection.pitching.SO - avgPitching.SO) / stddevPitching.SO;
-        pPitcher->calculations.zPitching.ERA = (pPitcher->projection.pitching.ERA() - avgPitching.ERA) / stddevPitching.ERA;
-        pPitcher->calculations.zPitching.WHIP = (pPitcher->projection.pitching.WHIP() - avgPitching.WHIP) / stddevPitching.WHIP;
-    }
-
-    sumPitching.ERA = 0;
-    sumPitching.WHIP = 0;
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        pPitcher->calculations.zPitching.ERA *= pPitcher->projection.pitching.IP;
-        pPitcher->calculations.zPitching.WHIP *= pPitcher->projection.pitching.IP;
-        sumPitching.ERA += pPitcher->calculations.zPitching.ERA;
-        sumPitching.WHIP += pPitcher->calculations.zPitching.WHIP;
-    }
-
-    stddevPitching.ERA = 0;
-    stddevPitching.WHIP = 0;
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        stddevPitching.ERA += std::pow(pPitcher->calculations.zPitching.ERA - avgPitching.ERA, 2.0);
-        stddevPitching.WHIP += std::pow(pPitcher->calculations.zPitching.WHIP - avgPitching.WHIP, 2.0);
-    }
-    stddevPitching.ERA = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.ERA);
-    stddevPitching.WHIP = std::sqrt(1. / double(vecPitchers.size()) * stddevPitching.WHIP);
-
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        pPitcher->calculations.zPitching.ERA = -1. * (pPitcher->calculations.zPitching.ERA - avgPitching.ERA) / stddevPitching.ERA;
-        pPitcher->calculations.zPitching.WHIP = -1. * (pPitcher->calculations.zPitching.WHIP - avgPitching.WHIP) / stddevPitching.WHIP;
-    }
-
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        pPitcher->calculations.zScore = 0;
-        if (fbbApp->Settings()->categories.pitching.ERA) {
-            pPitcher->calculations.zScore += pPitcher->calculations.zPitching.ERA;
-        }
-        if (fbbApp->Settings()->categories.pitching.SO) {
-            pPitcher->calculations.zScore += pPitcher->calculations.zPitching.SO;
-        }
-        if (fbbApp->Settings()->categories.pitching.SV) {
-            pPitcher->calculations.zScore += pPitcher->calculations.zPitching.SV;
-        }
-        if (fbbApp->Settings()->categories.pitching.W) {
-            pPitcher->calculations.zScore += pPitcher->calculations.zPitching.W;
-        }
-        if (fbbApp->Settings()->categories.pitching.WHIP) {
-            pPitcher->calculations.zScore += pPitcher->calculations.zPitching.WHIP;
-        }
-    }
-
-    // Sort by zScore
-    std::sort(vecPitchers.begin(), vecPitchers.end(), [](const FBBPlayer* pLHS, const FBBPlayer* pRHS) {
-        return pLHS->calculations.zScore > pRHS->calculations.zScore;
-    });
+        if (vecNext == vecPool || vecNext == vecPrevious || iteration + 1 == MAX_ITERATIONS) {
+            break;
+        }
+        vecPrevious.swap(vecPool);
+        vecPool.swap(vecNext);
+    }
+}
+
+// League-wide roster slots of one player type
+static std::vector<FBBRosterSlots::Slot> LeaugeSlots(const FBBLeaugeSettings* pSettings, FBBPlayer::PlayerType type)
+{
+    std::vector<FBBRosterSlots::Slot> ret = FBBTeamSlots(*pSettings, type);
+    for (FBBRosterSlots::Slot& slot : ret) {
+        slot.second *= static_cast<uint32_t>(pSettings->owners.size());
+    }
+    return ret;
+}
 
-    // Get replacement player
-    const size_t numDraftedPitchers = fbbApp->Settings()->SumPitchers() * fbbApp->Settings()->owners.size();
-    if (numDraftedPitchers >= vecPitchers.size()) {
+void FBBDraftBoardModel::ResetValuation(FBBPlayer::PlayerType type, const std::vector<uint32_t>& vecRows)
+{
+    if (!m_pStore) {
         return;
     }
-    double replacementZ = vecPitchers[numDraftedPitchers]->calculations.zScore;
 
-    // Normalize zScores
-    double sumZ = 0;
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        pPitcher->calculations.zScore -= replacementZ;
-        if (pPitcher->calculations.zScore > 0.0) {
-            sumZ += pPitcher->calculations.zScore;
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    const bool isHitter = type == FBBPlayer::PLAYER_TYPE_HITTER;
+    const double totalMoney = pSettings->leauge.budget * pSettings->owners.size();
+    const double split = pSettings->projections.hittingPitchingSplit;
+    const double money = (isHitter ? split : 1.0 - split) * totalMoney;
+    FBBPlayerColumns& columns = m_pStore->Columns(type);
+
+    if (pSettings->projections.replacement == FBBLeaugeSettings::Projections::Replacement::Position) {
+        std::vector<FBBPositionMask> vecEligible(columns.Count());
+        for (uint32_t row = 0; row < columns.Count(); row++) {
+            vecEligible[row] = m_pStore->Player(type, row)->EligablePositions();
         }
+        Valuation(type).Reset(columns, vecRows, LeaugeSlots(pSettings, type), vecEligible, money);
+    } else {
+        const size_t numDrafted = (isHitter ? pSettings->SumHitters() : pSettings->SumPitchers()) * pSettings->owners.size();
+        Valuation(type).Reset(columns, vecRows, numDrafted, money);
     }
 
-    // Calculate cost estimates
-    const double totalMoney = fbbApp->Settings()->leauge.budget * fbbApp->Settings()->owners.size();
-    const double totalPitchingMoney = (1.0 - fbbApp->Settings()->projections.hittingPitchingSplit) * totalMoney;
-    const double costPerZ = totalPitchingMoney / sumZ;
-    for (FBBPlayer* pPitcher : vecPitchers) {
-        pPitcher->calculations.estimate = pPitcher->calculations.zScore * costPerZ;
+    // The board shows ranks (batch valuations can skip this)
+    Valuation(type).Rank();
+}
+
+void FBBDraftBoardModel::Recalculate()
+{
+    FBB_TRACE_SCOPE("FBBDraftBoardModel::Recalculate");
+
+    CalculateZScores();
+    ResetInflation(true);
+    Simulate();
+    emit dataChanged(index(0, 0), index(rowCount() - 1, COLUMN_COUNT - 1));
+    emit headerDataChanged(Qt::Horizontal, COLUMN_Z, COLUMN_INFLATED);
+}
+
+std::vector<FBBWhatIf::Result> FBBDraftBoardModel::WhatIf(const std::vector<FBBWhatIf::Purchase>& vecPurchases)
+{
+    if (!m_pStore) {
+        return FBBWhatIf::Evaluate(nullptr, vecPurchases);
+    }
+
+    if (!m_spWhatIf) {
+        m_spWhatIf = FBBWhatIf::Capture(*m_pStore, *fbbApp->Settings(), m_inflation);
+    }
+    return FBBWhatIf::Evaluate(m_spWhatIf, vecPurchases);
+}
+
+void FBBDraftBoardModel::DraftPlayer(FBBPlayer* pPlayer, FBBOwnerId owner, uint32_t paid)
+{
+    FBB_TRACE_SCOPE("FBBDraftBoardModel::DraftPlayer");
+
+    if (!pPlayer || !owner || pPlayer->Owner() != 0) {
+        return;
     }
+
+    // A pick from outside the draftable pool changes the pool, so the
+    // category statistics have to be redone
+    const FBBPlayer::PlayerType type = pPlayer->Type();
+    const std::vector<uint32_t>& vecPool = DraftablePool(type);
+    const bool isDraftable = fbbApp->Settings()->projections.pool == FBBLeaugeSettings::Projections::Pool::Draftable;
+    if (isDraftable && !std::binary_search(vecPool.begin(), vecPool.end(), pPlayer->Row())) {
+        pPlayer->FreezeEstimate();
+        pPlayer->Owner() = owner;
+        pPlayer->Paid() = paid;
+        m_inflation.Draft(pPlayer->BaseValue(), paid);
+        m_spWhatIf.reset();
+        CalculateZScores(type);
+        Simulate();
+        emit dataChanged(index(0, 0), index(rowCount() - 1, COLUMN_COUNT - 1));
+        emit headerDataChanged(Qt::Horizontal, COLUMN_INFLATED, COLUMN_INFLATED);
+        emit PlayerDrafted(pPlayer);
+        return;
+    }
+
+    // Reprice before the owner is set so the estimate is frozen at its
+    // pre-pick value
+    Valuation(type).Draft(pPlayer->Row(), paid);
+    pPlayer->Owner() = owner;
+    pPlayer->Paid() = paid;
+    m_inflation.Draft(pPlayer->BaseValue(), paid);
+    m_spWhatIf.reset();
+    Simulate();
+
+    // The drafted row changes style, everyone else only changes price
+    const int row = ModelRow(pPlayer);
+    emit dataChanged(index(row, 0), index(row, COLUMN_COUNT - 1));
+    emit dataChanged(index(0, COLUMN_ESTIMATE), index(rowCount() - 1, COLUMN_AVAILABLE), { Qt::DisplayRole, Qt::ToolTipRole, RawDataRole });
+    emit headerDataChanged(Qt::Horizontal, COLUMN_INFLATED, COLUMN_INFLATED);
+    emit PlayerDrafted(pPlayer);
+}
+
+void FBBDraftBoardModel::ResetInflation(bool rebase)
+{
+    m_spWhatIf.reset();
+    if (!m_pStore) {
+        return;
+    }
+
+    // Everyone worth something is expected to be bought
+    double totalValue = 0;
+    for (FBBPlayer::PlayerType type : { FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::PLAYER_TYPE_PITCHER }) {
+        FBBPlayerColumns& columns = m_pStore->Columns(type);
+        if (rebase) {
+            std::fill(columns.baseValue.begin(), columns.baseValue.end(), 0.f);
+        }
+        for (uint32_t row : GetValidRows(type)) {
+            FBBPlayer* pPlayer = m_pStore->Player(type, row);
+            if (rebase) {
+                pPlayer->BaseValue() = pPlayer->Estimate();
+            }
+            totalValue += std::max(0.f, pPlayer->BaseValue());
+        }
+    }
+
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    m_inflation.Reset(pSettings->leauge.budget * pSettings->owners.size(), totalValue);
+    for (const FBBPlayer* pPlayer : m_vecPlayers) {
+        if (pPlayer->Owner() != 0) {
+            m_inflation.Draft(pPlayer->BaseValue(), pPlayer->Paid());
+        }
+    }
+}
+
+void FBBDraftBoardModel::Simulate()
+{
+    // Simulations of the rest of the auction (and the seed that makes a board
+    // state always give the same answer)
+    static const uint32_t NUM_SIMULATIONS = 4000;
+    static const uint64_t SEED = 0x46424253494D0000ull;
+
+    // Paid-over-value is shrunk towards neutral until an owner has spent this much
+    static const double AGGRESSION_PRIOR = 50.0;
+
+    m_pSimulator->Cancel();
+    m_vecSimulated.clear();
+    if (!m_pStore) {
+        return;
+    }
+
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    FBBAuctionSimulator::State state;
+    std::map<FBBOwnerId, size_t> mapOwners;
+    for (const auto& owner : pSettings->owners) {
+        mapOwners[owner.first] = state.vecOwners.size();
+        const uint32_t numHitters = static_cast<uint32_t>(pSettings->SumHitters());
+        const uint32_t numPitchers = static_cast<uint32_t>(pSettings->SumPitchers());
+        state.vecOwners.push_back({ int32_t(pSettings->leauge.budget), numHitters, numPitchers, pSettings->positions.numBench, 1.f });
+    }
+
+    // Take drafted players off their owner's budget and roster, and measure
+    // how far over value each owner has been paying
+    std::vector<double> vecPaid(state.vecOwners.size(), 0.0);
+    std::vector<double> vecValue(state.vecOwners.size(), 0.0);
+    uint64_t numDrafted = 0;
+    for (FBBPlayer* pPlayer : m_vecPlayers) {
+        // Undrafted players are priced live and keep their last results until
+        // new ones arrive
+        if (pPlayer->Owner() == 0 && pPlayer->IsValidUnderCurrentSettings()) {
+            state.vecPlayers.push_back({ pPlayer->Type(), std::max(1.f, pPlayer->Estimate()) });
+            m_vecSimulated.push_back(pPlayer);
+            continue;
+        }
+
+        FBBPlayerColumns& columns = m_pStore->Columns(pPlayer->Type());
+        const uint32_t row = pPlayer->Row();
+        columns.marketPrice[row] = columns.marketLow[row] = columns.marketHigh[row] = columns.available[row] = 0.f;
+        if (pPlayer->Owner() == 0) {
+            continue;
+        }
+
+        numDrafted++;
+        auto itr = mapOwners.find(pPlayer->Owner());
+        if (itr == mapOwners.end()) {
+            continue;
+        }
+        FBBAuctionSimulator::Owner& owner = state.vecOwners[itr->second];
+        owner.budget = std::max(0, owner.budget - int32_t(pPlayer->Paid()));
+        uint32_t& typeSlots = pPlayer->Type() == FBBPlayer::PLAYER_TYPE_HITTER ? owner.hitters : owner.pitchers;
+        if (typeSlots > 0) {
+            typeSlots--;
+        } else if (owner.bench > 0) {
+            owner.bench--;
+        }
+
+        // Picks loaded from a file have no frozen estimate to compare against
+        const float frozen = pPlayer->FrozenEstimate();
+        if (frozen > 0) {
+            vecPaid[itr->second] += pPlayer->Paid();
+            vecValue[itr->second] += std::max(1.f, frozen);
+        }
+    }
+    for (size_t i = 0; i < state.vecOwners.size(); i++) {
+        const double aggression = (vecPaid[i] + AGGRESSION_PRIOR) / (vecValue[i] + AGGRESSION_PRIOR);
+        state.vecOwners[i].aggression = float(std::min(2.0, std::max(0.5, aggression)));
+    }
+
+    m_pSimulator->Start(state, NUM_SIMULATIONS, SEED + numDrafted);
+}
+
+void FBBDraftBoardModel::OnSimulationProgress()
+{
+    // Progress from a cancelled run can still be queued
+    const std::vector<FBBAuctionSimulator::Result> vecResults = m_pSimulator->Results();
+    if (vecResults.size() != m_vecSimulated.size() || vecResults.empty()) {
+        return;
+    }
+
+    for (size_t i = 0; i < vecResults.size(); i++) {
+        FBBPlayerColumns& columns = m_pStore->Columns(m_vecSimulated[i]->Type());
+        const uint32_t row = m_vecSimulated[i]->Row();
+        columns.marketPrice[row] = vecResults[i].meanPrice;
+        columns.marketLow[row] = vecResults[i].lowPrice;
+        columns.marketHigh[row] = vecResults[i].highPrice;
+        columns.available[row] = vecResults[i].available;
+    }
+
+    emit dataChanged(index(0, COLUMN_MARKET), index(rowCount() - 1, COLUMN_AVAILABLE), { Qt::DisplayRole, Qt::ToolTipRole, RawDataRole });
 }
@@ -2,44 +2,58 @@
 #include "FBB/FBBDraftBoardModel.h"
 #include "FBB/FBBPlayer.h"
 #include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBTrace.h"
 
 FBBDraftBoardSortFilterProxyModel::FBBDraftBoardSortFilterProxyModel(QObject* parent)
     : QSortFilterProxyModel(parent)
 {
     connect(fbbApp->Settings(), &FBBLeaugeSettings::SettingsChanged, this, [=]() {
-        invalidateFilter();
+        Refilter();
     });
 }
 
 void FBBDraftBoardSortFilterProxyModel::SetOnlyHitters(bool enable)
 {
     m_onlyHitters = enable;
-    emit invalidateFilter();
+    Refilter();
 }
 
 void FBBDraftBoardSortFilterProxyModel::SetOnlyPitchers(bool enable)
 {
     m_onlyPitchers = enable;
-    emit invalidateFilter();
+    Refilter();
 }
 
 void FBBDraftBoardSortFilterProxyModel::SetShowDrafted(bool enable)
 {
     m_showDrafted = enable;
-    emit invalidateFilter();
+    Refilter();
 }
 
 void FBBDraftBoardSortFilterProxyModel::SetPositionFilter(FBBPositionMask mask)
 {
     m_positionFilter = mask;
-    emit invalidateFilter();
+    Refilter();
+}
+
+void FBBDraftBoardSortFilterProxyModel::Refilter()
+{
+    FBB_TRACE_SCOPE("FBBDraftBoardSortFilterProxyModel::filterAcceptsRow batch");
+    invalidateFilter();
+}
+
+void FBBDraftBoardSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+    FBB_TRACE_SCOPE("FBBDraftBoardSortFilterProxyModel::lessThan batch");
+    QSortFilterProxyModel::sort(column, order);
 }
 
 bool FBBDraftBoardSortFilterProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const QVariant& leftData = sourceModel()->data(left, FBBDraftBoardModel::RawDataRole);
-    const QVariant& rightData = sourceModel()->data(right, FBBDraftBoardModel::RawDataRole);
-    return leftData < rightData;
+    // Ranks are cached by the model until the column's values change
+    const FBBDraftBoardModel* pModel = static_cast<const FBBDraftBoardModel*>(sourceModel());
+    const std::vector<uint32_t>& vecRanks = pModel->SortRanks(left.column());
+    return vecRanks[left.row()] < vecRanks[right.row()];
 }
 
 bool FBBDraftBoardSortFilterProxyModel::filterAcceptsColumn(int sourceColumn, const QModelIndex& sourceParent) const
@@ -55,17 +69,17 @@ bool FBBDraftBoardSortFilterProxyModel::filterAcceptsRow(int sourceRow, const QM
         return false;
     }
 
-    if (m_onlyHitters && pPlayer->type != FBBPlayer::PLAYER_TYPE_HITTER)
+    if (m_onlyHitters && pPlayer->Type() != FBBPlayer::PLAYER_TYPE_HITTER)
     {
         return false;
     }
 
-    if (m_onlyPitchers && pPlayer->type != FBBPlayer::PLAYER_TYPE_PITCHER)
+    if (m_onlyPitchers && pPlayer->Type() != FBBPlayer::PLAYER_TYPE_PITCHER)
     {
         return false;
     }
 
-    if (!m_showDrafted && pPlayer->draftInfo.owner)
+    if (!m_showDrafted && pPlayer->Owner())
     {
         return false;
     }
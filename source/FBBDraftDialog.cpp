@@ -1,4 +1,5 @@
 #include "FBB/FBBDraftDialog.h"
+#include "FBB/FBBDraftBoardModel.h"
 #include "FBB/FBBPlayer.h"
 #include "FBB/FBBPosition.h"
 #include "FBB/FBBLeaugeSettings.h"
@@ -46,7 +47,7 @@ FBBDraftDialog::FBBDraftDialog(FBBPlayer* pPlayer)
 
     // Player name
     pInfoGridLayout->addWidget(new QLabel("Player Name:"), PlayerNameRow, LabelColumn);
-    pInfoGridLayout->addWidget(new QLabel(pPlayer->name), PlayerNameRow, ItemColumn);
+    pInfoGridLayout->addWidget(new QLabel(pPlayer->Name()), PlayerNameRow, ItemColumn);
 
     // Owner combo box
     const QString defaultOwnerText = "Select...";
@@ -90,19 +91,17 @@ FBBDraftDialog::FBBDraftDialog(FBBPlayer* pPlayer)
     // Accept
     connect(pDraftButton, &QPushButton::clicked, this, [=]() {
         
-        // apply paid
-        pPlayer->draftInfo.paid = m_paid;
-        
-        // apply owner
+        // find owner
+        FBBOwnerId owner = 0;
         for (const auto& item : fbbApp->Settings()->owners) {
              if (item.second->name == m_owner) {
-                 pPlayer->draftInfo.owner = item.first;
+                 owner = item.first;
                  break;
             }
          }
 
-        // signal
-        /// emit FBBPlayerDataService::Instance().PlayerDrafted(pPlayer);
+        // draft (reprices the board and signals the draft log)
+        fbbApp->DraftBoardModel()->DraftPlayer(pPlayer, owner, uint32_t(m_paid));
 
         accept();
     });
@@ -18,6 +18,20 @@ FBBDraftLogModel::FBBDraftLogModel(QObject* pParent)
         m_vecDraftedPlayers.push_back(pPlayer);
         endResetModel();
     });
+
+    // A loaded draft replaces the log with everyone owned
+    connect(fbbApp->DraftBoardModel(), &FBBDraftBoardModel::DraftLoaded, this, [=]() {
+        FBBDraftBoardModel* pModel = fbbApp->DraftBoardModel();
+        beginResetModel();
+        m_vecDraftedPlayers.clear();
+        for (uint32_t i = 0; i < pModel->PlayerCount(); i++) {
+            FBBPlayer* pPlayer = pModel->GetPlayer(i);
+            if (pPlayer->Owner() != 0) {
+                m_vecDraftedPlayers.push_back(pPlayer);
+            }
+        }
+        endResetModel();
+    });
 }
 
 int FBBDraftLogModel::rowCount(const QModelIndex& parent) const
@@ -40,11 +54,11 @@ QVariant FBBDraftLogModel::data(const QModelIndex& index, int role) const
         case DRAFTLOG_ID:
             return index.row();
         case DRAFTLOG_NAME:
-            return pPlayer->name;
+            return pPlayer->Name();
         case DRAFTLOG_OWNER:
-            return pPlayer->draftInfo.owner;
+            return pPlayer->Owner();
         case DRAFTLOG_PRICE:
-            return pPlayer->draftInfo.paid;
+            return pPlayer->Paid();
         default:
             break;
         }
@@ -0,0 +1,34 @@
+#include "FBB/FBBInflation.h"
+
+#include <algorithm>
+
+void FBBInflation::Reset(double totalMoney, double totalValue)
+{
+    m_totalMoney = totalMoney;
+    m_totalValue = totalValue;
+    m_spent = 0;
+    m_valueBought = 0;
+    Update();
+}
+
+void FBBInflation::Draft(float value, uint32_t paid)
+{
+    m_spent += paid;
+    m_valueBought += std::max(0.f, value);
+    Update();
+}
+
+void FBBInflation::Undraft(float value, uint32_t paid)
+{
+    m_spent -= paid;
+    m_valueBought -= std::max(0.f, value);
+    Update();
+}
+
+void FBBInflation::Update()
+{
+    // Once the valued players are gone there is nothing left to inflate
+    const double money = std::max(0.0, m_totalMoney - m_spent);
+    const double value = m_totalValue - m_valueBought;
+    m_factor = value > 0.5 ? float(money / value) : 1.f;
+}
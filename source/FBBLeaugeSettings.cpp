@@ -1,6 +1,105 @@
 #include "FBB/FBBLeaugeSettings.h"
 
 #include <QApplication>
+#include <QJsonArray>
+
+#include <utility>
+
+// Serialized fields by name
+static const std::pair<const char*, bool FBBLeaugeSettings::Categories::Hitting::*> s_hittingCategories[] =
+{
+    { "AVG", &FBBLeaugeSettings::Categories::Hitting::AVG },
+    { "RBI", &FBBLeaugeSettings::Categories::Hitting::RBI },
+    { "R", &FBBLeaugeSettings::Categories::Hitting::R },
+    { "SB", &FBBLeaugeSettings::Categories::Hitting::SB },
+    { "HR", &FBBLeaugeSettings::Categories::Hitting::HR },
+    { "OBP", &FBBLeaugeSettings::Categories::Hitting::OBP },
+    { "SLG", &FBBLeaugeSettings::Categories::Hitting::SLG },
+    { "OPS", &FBBLeaugeSettings::Categories::Hitting::OPS },
+    { "H", &FBBLeaugeSettings::Categories::Hitting::H },
+    { "TB", &FBBLeaugeSettings::Categories::Hitting::TB },
+    { "BB", &FBBLeaugeSettings::Categories::Hitting::BB },
+    { "RBI+R", &FBBLeaugeSettings::Categories::Hitting::RBIpR },
+    { "xBH", &FBBLeaugeSettings::Categories::Hitting::xBH },
+    { "SB-CS", &FBBLeaugeSettings::Categories::Hitting::SBmCS },
+    { "wOBA", &FBBLeaugeSettings::Categories::Hitting::wOBA },
+};
+
+static const std::pair<const char*, bool FBBLeaugeSettings::Categories::Pitching::*> s_pitchingCategories[] =
+{
+    { "W", &FBBLeaugeSettings::Categories::Pitching::W },
+    { "SV", &FBBLeaugeSettings::Categories::Pitching::SV },
+    { "ERA", &FBBLeaugeSettings::Categories::Pitching::ERA },
+    { "WHIP", &FBBLeaugeSettings::Categories::Pitching::WHIP },
+    { "SO", &FBBLeaugeSettings::Categories::Pitching::SO },
+    { "AVG", &FBBLeaugeSettings::Categories::Pitching::AVG },
+    { "K/9", &FBBLeaugeSettings::Categories::Pitching::Kp9 },
+    { "K/BB", &FBBLeaugeSettings::Categories::Pitching::KpBB },
+    { "FIP", &FBBLeaugeSettings::Categories::Pitching::FIP },
+    { "HLD", &FBBLeaugeSettings::Categories::Pitching::HLD },
+    { "QS", &FBBLeaugeSettings::Categories::Pitching::QS },
+};
+
+static const std::pair<const char*, uint32_t FBBLeaugeSettings::Positions::Hitting::*> s_hittingPositions[] =
+{
+    { "C", &FBBLeaugeSettings::Positions::Hitting::numC },
+    { "1B", &FBBLeaugeSettings::Positions::Hitting::num1B },
+    { "2B", &FBBLeaugeSettings::Positions::Hitting::num2B },
+    { "SS", &FBBLeaugeSettings::Positions::Hitting::numSS },
+    { "3B", &FBBLeaugeSettings::Positions::Hitting::num3B },
+    { "MI", &FBBLeaugeSettings::Positions::Hitting::numMI },
+    { "CI", &FBBLeaugeSettings::Positions::Hitting::numCI },
+    { "IF", &FBBLeaugeSettings::Positions::Hitting::numIF },
+    { "LF", &FBBLeaugeSettings::Positions::Hitting::numLF },
+    { "CF", &FBBLeaugeSettings::Positions::Hitting::numCF },
+    { "RF", &FBBLeaugeSettings::Positions::Hitting::numRF },
+    { "OF", &FBBLeaugeSettings::Positions::Hitting::numOF },
+    { "DH", &FBBLeaugeSettings::Positions::Hitting::numDH },
+    { "U", &FBBLeaugeSettings::Positions::Hitting::numU },
+};
+
+static const std::pair<const char*, uint32_t FBBLeaugeSettings::Positions::Pitching::*> s_pitchingPositions[] =
+{
+    { "SP", &FBBLeaugeSettings::Positions::Pitching::numSP },
+    { "RP", &FBBLeaugeSettings::Positions::Pitching::numRP },
+    { "P", &FBBLeaugeSettings::Positions::Pitching::numP },
+};
+
+static QJsonValue ToJsonValue(bool value)
+{
+    return value;
+}
+
+static QJsonValue ToJsonValue(uint32_t value)
+{
+    return static_cast<int>(value);
+}
+
+template <typename Struct, typename Field, size_t N>
+static QJsonObject FieldsToJson(const Struct& fields, const std::pair<const char*, Field Struct::*> (&table)[N])
+{
+    QJsonObject json;
+    for (const auto& entry : table) {
+        json[entry.first] = ToJsonValue(fields.*entry.second);
+    }
+    return json;
+}
+
+template <typename Struct, size_t N>
+static void FieldsFromJson(const QJsonObject& json, Struct& fields, const std::pair<const char*, bool Struct::*> (&table)[N])
+{
+    for (const auto& entry : table) {
+        fields.*entry.second = json[entry.first].toBool(fields.*entry.second);
+    }
+}
+
+template <typename Struct, size_t N>
+static void FieldsFromJson(const QJsonObject& json, Struct& fields, const std::pair<const char*, uint32_t Struct::*> (&table)[N])
+{
+    for (const auto& entry : table) {
+        fields.*entry.second = static_cast<uint32_t>(json[entry.first].toInt(static_cast<int>(fields.*entry.second)));
+    }
+}
 
 FBBLeaugeSettings::FBBLeaugeSettings(QObject* parent)
     : QObject(parent)
@@ -19,4 +118,70 @@ FBBLeaugeSettings::FBBLeaugeSettings(QObject* parent)
     CreateOwner({ "Owner #12", "BIZ" });
 }
 
+const char* const FBBLeaugeSettings::FILE_NAME = "league.json";
+
+QJsonObject FBBLeaugeSettings::ToJson() const
+{
+    QJsonObject leaugeJson;
+    leaugeJson["type"] = static_cast<int>(leauge.type);
+    leaugeJson["budget"] = static_cast<int>(leauge.budget);
+    leaugeJson["positionEligibility"] = static_cast<int>(leauge.positionEligibility);
+
+    QJsonObject categoriesJson;
+    categoriesJson["hitting"] = FieldsToJson(categories.hitting, s_hittingCategories);
+    categoriesJson["pitching"] = FieldsToJson(categories.pitching, s_pitchingCategories);
+
+    QJsonObject positionsJson;
+    positionsJson["hitting"] = FieldsToJson(positions.hitting, s_hittingPositions);
+    positionsJson["pitching"] = FieldsToJson(positions.pitching, s_pitchingPositions);
+    positionsJson["bench"] = static_cast<int>(positions.numBench);
+
+    // Ids as strings, they don't fit in a double
+    QJsonArray ownersJson;
+    for (const auto& owner : owners) {
+        QJsonObject ownerJson;
+        ownerJson["id"] = QString::number(owner.first);
+        ownerJson["name"] = owner.second->name;
+        ownerJson["abbreviation"] = owner.second->abbreviation;
+        ownersJson.append(ownerJson);
+    }
+
+    QJsonObject json;
+    json["leauge"] = leaugeJson;
+    json["categories"] = categoriesJson;
+    json["positions"] = positionsJson;
+    json["owners"] = ownersJson;
+    return json;
+}
+
+void FBBLeaugeSettings::FromJson(const QJsonObject& json)
+{
+    const QJsonObject leaugeJson = json["leauge"].toObject();
+    leauge.type = Leauge::Type(leaugeJson["type"].toInt(static_cast<int>(leauge.type)));
+    leauge.budget = static_cast<uint32_t>(leaugeJson["budget"].toInt(static_cast<int>(leauge.budget)));
+    leauge.positionEligibility = static_cast<uint32_t>(leaugeJson["positionEligibility"].toInt(static_cast<int>(leauge.positionEligibility)));
+
+    const QJsonObject categoriesJson = json["categories"].toObject();
+    FieldsFromJson(categoriesJson["hitting"].toObject(), categories.hitting, s_hittingCategories);
+    FieldsFromJson(categoriesJson["pitching"].toObject(), categories.pitching, s_pitchingCategories);
+
+    const QJsonObject positionsJson = json["positions"].toObject();
+    FieldsFromJson(positionsJson["hitting"].toObject(), positions.hitting, s_hittingPositions);
+    FieldsFromJson(positionsJson["pitching"].toObject(), positions.pitching, s_pitchingPositions);
+    positions.numBench = static_cast<uint32_t>(positionsJson["bench"].toInt(static_cast<int>(positions.numBench)));
+
+    // A listed set of owners replaces the current one
+    const QJsonArray ownersJson = json["owners"].toArray();
+    if (!ownersJson.isEmpty()) {
+        owners.clear();
+        for (const QJsonValue& value : ownersJson) {
+            const QJsonObject ownerJson = value.toObject();
+            const FBBOwnerId id = ownerJson["id"].toString().toULongLong();
+            if (id) {
+                owners[id] = std::make_shared<Owner>(Owner{ ownerJson["name"].toString(), ownerJson["abbreviation"].toString() });
+            }
+        }
+    }
+}
+
 #include "FBBLeaugeSettings.moc"
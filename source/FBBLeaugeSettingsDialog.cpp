@@ -1,5 +1,6 @@
 #include "FBB/FBBLeaugeSettingsDialog.h"
 #include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBSGP.h"
 
 #include <QTabWidget>
 #include <QVBoxLayout>
@@ -20,6 +21,12 @@
 #include <QMessageBox>
 #include <QSlider>
 #include <QSpinBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QDoubleValidator>
+
+#include <memory>
+#include <vector>
 
 static void BuildOwnerLayout(QGridLayout* pOwnerLayout, FBBLeaugeSettings* pSettings)
 {
@@ -320,6 +327,9 @@ FBBLeaugeSettingsDialog::FBBLeaugeSettingsDialog(FBBLeaugeSettings* pSettings, Q
         QLabel* pDescription = new QLabel("Configuration projections and cost estimates", pTab);
         QFormLayout* pFormLayout = new QFormLayout();
         QComboBox* pSourceComboBox = new QComboBox();
+        QComboBox* pEngineComboBox = new QComboBox();
+        QComboBox* pReplacementComboBox = new QComboBox();
+        QComboBox* pPoolComboBox = new QComboBox();
         QWidget* pSplit = new QWidget();
         QHBoxLayout* pSplitLayout = new QHBoxLayout(pSplit);
         QSlider* pSplitSlider = new QSlider();
@@ -335,6 +345,18 @@ FBBLeaugeSettingsDialog::FBBLeaugeSettingsDialog(FBBLeaugeSettings* pSettings, Q
         pSourceComboBox->addItem("ATC");
         pSourceComboBox->setCurrentIndex(uint32_t(pSettings->projections.source));
 
+        pEngineComboBox->addItem("Z-Score");
+        pEngineComboBox->addItem("SGP");
+        pEngineComboBox->setCurrentIndex(uint32_t(pSettings->projections.engine));
+
+        pReplacementComboBox->addItem("Overall");
+        pReplacementComboBox->addItem("By Position");
+        pReplacementComboBox->setCurrentIndex(uint32_t(pSettings->projections.replacement));
+
+        pPoolComboBox->addItem("All Valid");
+        pPoolComboBox->addItem("Draftable");
+        pPoolComboBox->setCurrentIndex(uint32_t(pSettings->projections.pool));
+
         pSplitSlider->setOrientation(Qt::Horizontal);
         pSplitSlider->setMinimum(0);
         pSplitSlider->setMaximum(100);
@@ -358,6 +380,18 @@ FBBLeaugeSettingsDialog::FBBLeaugeSettingsDialog(FBBLeaugeSettings* pSettings, Q
             pSettings->projections.source = FBBLeaugeSettings::Projections::Source(index);
         });
 
+        connect(pEngineComboBox, static_cast<void (QComboBox::*)(int32_t)>(&QComboBox::currentIndexChanged), this, [=](int32_t index) {
+            pSettings->projections.engine = FBBLeaugeSettings::Projections::Engine(index);
+        });
+
+        connect(pReplacementComboBox, static_cast<void (QComboBox::*)(int32_t)>(&QComboBox::currentIndexChanged), this, [=](int32_t index) {
+            pSettings->projections.replacement = FBBLeaugeSettings::Projections::Replacement(index);
+        });
+
+        connect(pPoolComboBox, static_cast<void (QComboBox::*)(int32_t)>(&QComboBox::currentIndexChanged), this, [=](int32_t index) {
+            pSettings->projections.pool = FBBLeaugeSettings::Projections::Pool(index);
+        });
+
         connect(pSplitSlider, &QSlider::valueChanged, this, [=](int32_t value) {
             pSettings->projections.hittingPitchingSplit = value / 100.f;
             pSplitValue->setText(QString::number(value) + "%");
@@ -376,6 +410,9 @@ FBBLeaugeSettingsDialog::FBBLeaugeSettingsDialog(FBBLeaugeSettings* pSettings, Q
         });
 
         pFormLayout->addRow("Source:", pSourceComboBox);
+        pFormLayout->addRow("Valuation:", pEngineComboBox);
+        pFormLayout->addRow("Replacement Level:", pReplacementComboBox);
+        pFormLayout->addRow("Statistics Pool:", pPoolComboBox);
         pFormLayout->addRow("Hitting-to-Pitching Split:", pSplit);
         pFormLayout->addRow("Minimum AB:", pMinAB);
         pFormLayout->addRow("Minimum IP:", pMinIP);
@@ -388,6 +425,80 @@ FBBLeaugeSettingsDialog::FBBLeaugeSettingsDialog(FBBLeaugeSettings* pSettings, Q
         pTabWidget->addTab(pTab, "Projections");
     }
 
+    // Standings gain points
+    {
+        QWidget* pTab = new QWidget();
+        QVBoxLayout* pTabLayout = new QVBoxLayout(pTab);
+        QWidget* pGroups = new QWidget();
+        QHBoxLayout* pGroupLayout = new QHBoxLayout(pGroups);
+        QLabel* pDescription = new QLabel("Amount of each category needed to gain one place in the standings (SGP valuation)");
+        QGroupBox* pHittingGroup = new QGroupBox("Hitting");
+        QFormLayout* pHittingForm = new QFormLayout(pHittingGroup);
+        QGroupBox* pPitchingGroup = new QGroupBox("Pitching");
+        QFormLayout* pPitchingForm = new QFormLayout(pPitchingGroup);
+        QPushButton* pImportButton = new QPushButton("Import Standings...");
+        QHBoxLayout* pButtonLayout = new QHBoxLayout();
+
+        // Edits are refreshed after importing standings
+        struct Denominator
+        {
+            QLineEdit* pEdit;
+            QMap<QString, float>* pDenominators;
+            const FBBCategory* pCategory;
+        };
+        std::shared_ptr<std::vector<Denominator>> spDenominators = std::make_shared<std::vector<Denominator>>();
+
+        // Helper to add a new value (blank categories use their default)
+        auto AddValue = [=](QFormLayout* pForm, QMap<QString, float>& denominators, const FBBCategory& category) {
+            QLineEdit* pEdit = new QLineEdit();
+            pEdit->setValidator(new QDoubleValidator(0, 1000, 4, this));
+            pEdit->setText(QString::number(denominators.value(category.name, category.sgp)));
+            pForm->addRow(QString(category.name) + ":", pEdit);
+            connect(pEdit, &QLineEdit::textEdited, [=, &denominators](const QString& text) {
+                denominators[category.name] = text.toFloat();
+            });
+            spDenominators->push_back({ pEdit, &denominators, &category });
+        };
+
+        for (const FBBCategory& category : FBBCategories(FBBPlayer::PLAYER_TYPE_HITTER)) {
+            AddValue(pHittingForm, pSettings->sgp.hitting, category);
+        }
+        for (const FBBCategory& category : FBBCategories(FBBPlayer::PLAYER_TYPE_PITCHER)) {
+            AddValue(pPitchingForm, pSettings->sgp.pitching, category);
+        }
+
+        connect(pImportButton, &QPushButton::pressed, this, [=]() {
+            const QString path = QFileDialog::getOpenFileName(this, tr("Import Standings"), QString(), tr("CSV Files (*.csv)"));
+            if (path.isEmpty()) {
+                return;
+            }
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly) || FBBFitSGPDenominators(file.readAll(), pSettings->sgp) == 0) {
+                QMessageBox::warning(this, qApp->applicationName(), "No category standings were found in " + path);
+                return;
+            }
+            for (const Denominator& denominator : *spDenominators) {
+                const FBBCategory* pCategory = denominator.pCategory;
+                denominator.pEdit->setText(QString::number(denominator.pDenominators->value(pCategory->name, pCategory->sgp)));
+            }
+        });
+
+        pGroupLayout->setContentsMargins(0, 0, 0, 0);
+        pGroupLayout->addWidget(pHittingGroup);
+        pGroupLayout->addWidget(pPitchingGroup);
+        pGroupLayout->addStretch();
+
+        pButtonLayout->addStretch();
+        pButtonLayout->addWidget(pImportButton);
+
+        pTabLayout->addWidget(pDescription);
+        pTabLayout->addWidget(pGroups);
+        pTabLayout->addLayout(pButtonLayout);
+        pTabLayout->addStretch();
+
+        pTabWidget->addTab(pTab, "SGP");
+    }
+
     // Buttons
     {
         QWidget* pButtons = new QWidget();
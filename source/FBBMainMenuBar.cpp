@@ -2,10 +2,14 @@
 #include "FBB/FBBLeaugeSettingsDialog.h"
 #include "FBB/FBBLeaugeSettings.h"
 #include "FBB/FBBApplication.h"
+#include "FBB/FBBProjectionService.h"
+#include "FBB/FBBTrace.h"
 
 #include <QMenu>
 #include <QAction>
 #include <QApplication>
+#include <QFileDialog>
+#include <QStandardPaths>
 
 FBBMainMenuBar::FBBMainMenuBar(QWidget* parent)
     : QMenuBar(parent)
@@ -24,9 +28,40 @@ FBBMainMenuBar::FBBMainMenuBar(QWidget* parent)
         fbbApp->SaveAs();
     });
 
-    fileMenu->addAction("&Open", [=](){
-        // fbbApp->Open();
+    QAction* pOpenAction = fileMenu->addAction("&Open", [=](){
+        const QString docFolder = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        const QString file = QFileDialog::getOpenFileName(nullptr, tr("Open File"), docFolder, tr("JSON Files (*.json)"));
+        if (!file.isEmpty()) {
+            fbbApp->Load(file);
+        }
+    });
+
+    // Picks are matched against the projections, so wait for them
+    FBBProjectionService& projectionService = FBBProjectionService::Instance();
+    if (!projectionService.IsLoaded()) {
+        pOpenAction->setEnabled(false);
+        connect(&projectionService, &FBBProjectionService::ProjectionsLoaded, pOpenAction, [=]() {
+            pOpenAction->setEnabled(true);
+        });
+    }
+
+    fileMenu->addAction("Export &CSV...", [=](){
+        const QString docFolder = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        const QString file = QFileDialog::getSaveFileName(nullptr, tr("Export CSV"), docFolder, tr("CSV Files (*.csv)"));
+        if (!file.isEmpty()) {
+            fbbApp->ExportCSV(file);
+        }
+    });
+
+#ifdef FBB_TRACE
+    fileMenu->addAction("Save &Trace...", [=](){
+        const QString docFolder = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        const QString file = QFileDialog::getSaveFileName(nullptr, tr("Save Trace"), docFolder, tr("Trace Files (*.json)"));
+        if (!file.isEmpty()) {
+            FBBTrace::Write(file);
+        }
     });
+#endif
 
     // Settings
     QMenu* settingsMenu = addMenu("&Settings");
@@ -2,13 +2,16 @@
 #include "FBB/FBBMainMenuBar.h"
 #include "FBB/FBBDraftBoard.h"
 #include "FBB/FBBDraftLog.h"
+#include "FBB/FBBStandings.h"
 #include "FBB/FBBDraftBoardModel.h"
+#include "FBB/FBBProjectionService.h"
 
 #include <QGridLayout>
 #include <QTabWidget>
 #include <QDockWidget>
 #include <QTableView>
 #include <QFile>
+#include <QStatusBar>
 
 FBBMainWindow::FBBMainWindow(QWidget* parent, Qt::WindowFlags flags)
     : QMainWindow(parent, flags)
@@ -29,5 +32,20 @@ FBBMainWindow::FBBMainWindow(QWidget* parent, Qt::WindowFlags flags)
     // Add tabs
     pTabWidget->addTab(new FBBDraftBoard(this), "Draft");
     pTabWidget->addTab(new FBBDraftLog(this), "Log");
+    pTabWidget->addTab(new FBBStandings(this), "Standings");
+
+    // Loading state until the projections are in
+    FBBProjectionService& projectionService = FBBProjectionService::Instance();
+    if (!projectionService.IsLoaded()) {
+        pCentralWidget->setEnabled(false);
+        statusBar()->showMessage(tr("Loading projections..."));
+        connect(&projectionService, &FBBProjectionService::LoadProgress, this, [=](const QString& message) {
+            statusBar()->showMessage(message);
+        });
+        connect(&projectionService, &FBBProjectionService::ProjectionsLoaded, this, [=]() {
+            pCentralWidget->setEnabled(true);
+            statusBar()->clearMessage();
+        });
+    }
 }
 
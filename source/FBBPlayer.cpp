@@ -0,0 +1,71 @@
+#include "FBB/FBBPlayer.h"
+#include "FBB/FBBLeaugeSettings.h"
+#include "FBB/FBBApplication.h"
+
+FBBPositionMask FBBPlayer::EligablePositions() const
+{
+    FBBPositionMask mask = 0;
+
+    if (m_type == PLAYER_TYPE_PITCHER) {
+        if (Pitching(PITCHING_STAT_GS) > 0) {
+            mask |= FBB_POSITION_SP;
+        }
+        if (Pitching(PITCHING_STAT_G) > Pitching(PITCHING_STAT_GS)) {
+            mask |= FBB_POSITION_RP;
+        }
+        return mask | FBB_POSITION_P;
+    }
+
+    // Any appearance in the field counts
+    static const std::pair<Fielding, FBBPositionBits> s_LUT[] =
+    {
+        { FIELDING_C, FBB_POSITION_C },
+        { FIELDING_1B, FBB_POSITION_1B },
+        { FIELDING_2B, FBB_POSITION_2B },
+        { FIELDING_SS, FBB_POSITION_SS },
+        { FIELDING_3B, FBB_POSITION_3B },
+        { FIELDING_LF, FBB_POSITION_LF },
+        { FIELDING_CF, FBB_POSITION_CF },
+        { FIELDING_RF, FBB_POSITION_RF },
+    };
+    for (const auto& entry : s_LUT) {
+        if (Appearances(entry.first) > 0.f) {
+            mask |= entry.second;
+        }
+    }
+
+    // Hitters that never take the field are DH only
+    if (!mask) {
+        mask |= FBB_POSITION_DH;
+    }
+
+    // Aggregates
+    if (mask & (FBB_POSITION_1B | FBB_POSITION_3B)) {
+        mask |= FBB_POSITION_CI;
+    }
+    if (mask & (FBB_POSITION_2B | FBB_POSITION_SS)) {
+        mask |= FBB_POSITION_MI;
+    }
+    if (mask & (FBB_POSITION_1B | FBB_POSITION_2B | FBB_POSITION_SS | FBB_POSITION_3B)) {
+        mask |= FBB_POSITION_IF;
+    }
+    if (mask & (FBB_POSITION_LF | FBB_POSITION_CF | FBB_POSITION_RF)) {
+        mask |= FBB_POSITION_OF;
+    }
+    return mask | FBB_POSITION_U;
+}
+
+bool FBBPlayer::IsValidUnderCurrentSettings() const
+{
+    const FBBLeaugeSettings::Projections& projections = fbbApp->Settings()->projections;
+
+    if (!projections.includeFA && Team() == FBBTeam::FA) {
+        return false;
+    }
+
+    if (m_type == PLAYER_TYPE_HITTER) {
+        return Hitting(HITTING_STAT_AB) >= projections.minAB;
+    } else {
+        return Pitching(PITCHING_STAT_IP) >= projections.minIP;
+    }
+}
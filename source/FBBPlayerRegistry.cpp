@@ -0,0 +1,135 @@
+#include "FBB/FBBPlayerRegistry.h"
+
+#include <cstring>
+
+// Initial table size (the table is kept at most half full)
+static const size_t MIN_SLOTS = 1024;
+
+uint32_t FBBPlayerRegistry::Hash(const char* pId, uint32_t size)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint8_t>(pId[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Slot holding the id, or the empty slot it would be inserted into
+size_t FBBPlayerRegistry::FindSlot(const char* pId, uint32_t size, uint32_t hash) const
+{
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+
+        const Slot& slot = m_slots[i];
+        if (slot.handle == FBB_INVALID_PLAYER_HANDLE) {
+            return i;
+        }
+
+        // Only touch the pool on a full hash match
+        if (slot.hash == hash) {
+            const uint32_t offset = m_offsets[slot.handle];
+            if (m_offsets[slot.handle + 1] - offset == size && memcmp(m_pool.data() + offset, pId, size) == 0) {
+                return i;
+            }
+        }
+    }
+}
+
+void FBBPlayerRegistry::Grow()
+{
+    std::vector<Slot> vecSlots(m_slots.empty() ? MIN_SLOTS : m_slots.size() * 2);
+    const size_t mask = vecSlots.size() - 1;
+
+    for (const Slot& slot : m_slots) {
+        if (slot.handle == FBB_INVALID_PLAYER_HANDLE) {
+            continue;
+        }
+        size_t i = slot.hash & mask;
+        while (vecSlots[i].handle != FBB_INVALID_PLAYER_HANDLE) {
+            i = (i + 1) & mask;
+        }
+        vecSlots[i] = slot;
+    }
+
+    m_slots.swap(vecSlots);
+}
+
+FBBPlayerHandle FBBPlayerRegistry::Intern(const char* pId, uint32_t size)
+{
+    if ((Count() + 1) * 2 > m_slots.size()) {
+        Grow();
+    }
+
+    const uint32_t hash = Hash(pId, size);
+    Slot& slot = m_slots[FindSlot(pId, size, hash)];
+    if (slot.handle != FBB_INVALID_PLAYER_HANDLE) {
+        return slot.handle;
+    }
+
+    // New id
+    slot.hash = hash;
+    slot.handle = Count();
+    m_pool.insert(m_pool.end(), pId, pId + size);
+    m_offsets.push_back(static_cast<uint32_t>(m_pool.size()));
+    m_hitters.push_back(nullptr);
+    m_pitchers.push_back(nullptr);
+    return slot.handle;
+}
+
+FBBPlayerHandle FBBPlayerRegistry::Register(FBBPlayer* pPlayer)
+{
+    const QByteArray id = pPlayer->Id().toUtf8();
+    const FBBPlayerHandle handle = Intern(id.constData(), static_cast<uint32_t>(id.size()));
+    pPlayer->Handle() = handle;
+
+    switch (pPlayer->Type())
+    {
+    case FBBPlayer::PLAYER_TYPE_HITTER:
+        m_hitters[handle] = pPlayer;
+        break;
+    case FBBPlayer::PLAYER_TYPE_PITCHER:
+        m_pitchers[handle] = pPlayer;
+        break;
+    }
+
+    return handle;
+}
+
+FBBPlayerHandle FBBPlayerRegistry::Find(const char* pId, uint32_t size) const
+{
+    if (m_slots.empty()) {
+        return FBB_INVALID_PLAYER_HANDLE;
+    }
+
+    return m_slots[FindSlot(pId, size, Hash(pId, size))].handle;
+}
+
+FBBPlayerHandle FBBPlayerRegistry::Find(const QByteArray& id) const
+{
+    return Find(id.constData(), static_cast<uint32_t>(id.size()));
+}
+
+FBBPlayerHandle FBBPlayerRegistry::Find(const QString& id) const
+{
+    return Find(id.toUtf8());
+}
+
+FBBPlayer* FBBPlayerRegistry::Player(FBBPlayerHandle handle, FBBPlayer::PlayerType type) const
+{
+    if (handle >= Count()) {
+        return nullptr;
+    }
+
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? m_hitters[handle] : m_pitchers[handle];
+}
+
+void FBBPlayerRegistry::Clear()
+{
+    m_slots.clear();
+    m_pool.clear();
+    m_offsets.assign(1, 0);
+    m_hitters.clear();
+    m_pitchers.clear();
+}
@@ -0,0 +1,119 @@
+#include "FBB/FBBPlayerStore.h"
+
+FBBPlayerStore::FBBPlayerStore()
+{
+    m_hitters.stats.resize(FBBPlayer::HittingStats_Count);
+    m_hitters.z.resize(FBBPlayer::HittingCategory_Count);
+    m_pitchers.stats.resize(FBBPlayer::PitchingStats_Count);
+    m_pitchers.z.resize(FBBPlayer::PitchingCategory_Count);
+}
+
+FBBPlayerColumns& FBBPlayerStore::Columns(FBBPlayer::PlayerType type)
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? m_hitters : m_pitchers;
+}
+
+const FBBPlayerColumns& FBBPlayerStore::Columns(FBBPlayer::PlayerType type) const
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? m_hitters : m_pitchers;
+}
+
+std::deque<FBBPlayer>& FBBPlayerStore::Views(FBBPlayer::PlayerType type)
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? m_hitterViews : m_pitcherViews;
+}
+
+void FBBPlayerStore::Reserve(FBBPlayer::PlayerType type, uint32_t count)
+{
+    FBBPlayerColumns& columns = Columns(type);
+    columns.stringOffsets.reserve(2 * size_t(count) + 1);
+    columns.handle.reserve(count);
+    columns.team.reserve(count);
+    columns.age.reserve(count);
+    columns.experience.reserve(count);
+    for (std::vector<uint32_t>& stat : columns.stats) {
+        stat.reserve(count);
+    }
+    for (std::vector<float>& fielding : columns.fielding) {
+        fielding.reserve(count);
+    }
+    for (std::vector<float>& z : columns.z) {
+        z.reserve(count);
+    }
+    columns.zScore.reserve(count);
+    columns.estimate.reserve(count);
+    columns.rank.reserve(count);
+    columns.pooled.reserve(count);
+    columns.scarcity.reserve(count);
+    columns.marketPrice.reserve(count);
+    columns.marketLow.reserve(count);
+    columns.marketHigh.reserve(count);
+    columns.available.reserve(count);
+    columns.baseValue.reserve(count);
+    columns.owner.reserve(count);
+    columns.paid.reserve(count);
+    columns.position.reserve(count);
+}
+
+FBBPlayer* FBBPlayerStore::Add(FBBPlayer::PlayerType type, const QString& id, const QString& name)
+{
+    FBBPlayerColumns& columns = Columns(type);
+    const uint32_t row = columns.Count();
+
+    // Strings
+    columns.pool.insert(columns.pool.end(), id.constData(), id.constData() + id.size());
+    columns.stringOffsets.push_back(static_cast<uint32_t>(columns.pool.size()));
+    columns.pool.insert(columns.pool.end(), name.constData(), name.constData() + name.size());
+    columns.stringOffsets.push_back(static_cast<uint32_t>(columns.pool.size()));
+
+    // Identity
+    columns.handle.push_back(FBB_INVALID_PLAYER_HANDLE);
+    columns.team.push_back(FBBTeam::Unknown);
+    columns.age.push_back(0);
+    columns.experience.push_back(0);
+
+    // Projection
+    for (std::vector<uint32_t>& stat : columns.stats) {
+        stat.push_back(0);
+    }
+    for (std::vector<float>& fielding : columns.fielding) {
+        fielding.push_back(0.f);
+    }
+
+    // Calculations
+    for (std::vector<float>& z : columns.z) {
+        z.push_back(0.f);
+    }
+    columns.zScore.push_back(0.f);
+    columns.estimate.push_back(0.f);
+    columns.rank.push_back(0);
+    columns.pooled.push_back(0);
+    columns.scarcity.push_back(0.f);
+    columns.marketPrice.push_back(0.f);
+    columns.marketLow.push_back(0.f);
+    columns.marketHigh.push_back(0.f);
+    columns.available.push_back(0.f);
+    columns.baseValue.push_back(0.f);
+
+    // Draft info
+    columns.owner.push_back(0);
+    columns.paid.push_back(0);
+    columns.position.push_back(FBB_POSITION_UNKNOWN);
+
+    std::deque<FBBPlayer>& views = Views(type);
+    views.emplace_back(&columns, type, row);
+    return &views.back();
+}
+
+std::vector<FBBPlayer*> FBBPlayerStore::Players()
+{
+    std::vector<FBBPlayer*> ret;
+    ret.reserve(m_hitterViews.size() + m_pitcherViews.size());
+    for (FBBPlayer& player : m_hitterViews) {
+        ret.push_back(&player);
+    }
+    for (FBBPlayer& player : m_pitcherViews) {
+        ret.push_back(&player);
+    }
+    return ret;
+}
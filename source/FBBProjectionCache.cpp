@@ -0,0 +1,293 @@
+#include "FBB/FBBProjectionCache.h"
+#include "FBB/FBBPlayer.h"
+#include "FBB/FBBPlayerStore.h"
+#include "FBB/FBBTrace.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cstring>
+
+// Bump whenever the layout below changes
+static const uint32_t SNAPSHOT_VERSION = 2;
+static const char SNAPSHOT_MAGIC[4] = { 'F', 'B', 'B', 'S' };
+
+struct SnapshotHeader
+{
+    char magic[4];
+    uint32_t version;
+    char hash[20];
+    uint32_t hitterCount;
+    uint32_t pitcherCount;
+    uint32_t stringCount;
+    uint32_t poolSize;
+};
+
+static_assert(sizeof(SnapshotHeader) == 44, "Snapshot header must be packed");
+
+// Byte offsets of each column. Four byte columns come first so everything is
+// naturally aligned in the mapping.
+struct SnapshotLayout
+{
+    SnapshotLayout(const SnapshotHeader& header)
+    {
+        const uint64_t numHitters = header.hitterCount;
+        const uint64_t numPitchers = header.pitcherCount;
+        const uint64_t numPlayers = numHitters + numPitchers;
+
+        hitting       = sizeof(SnapshotHeader);
+        pitching      = hitting + FBBPlayer::HittingStats_Count * numHitters * sizeof(uint32_t);
+        fielding      = pitching + FBBPlayer::PitchingStats_Count * numPitchers * sizeof(uint32_t);
+        age           = fielding + FBBPlayer::Fielding_Count * numPlayers * sizeof(float);
+        experience    = age + numPlayers * sizeof(uint32_t);
+        idString      = experience + numPlayers * sizeof(uint32_t);
+        nameString    = idString + numPlayers * sizeof(uint32_t);
+        stringOffsets = nameString + numPlayers * sizeof(uint32_t);
+        pool          = stringOffsets + (uint64_t(header.stringCount) + 1) * sizeof(uint32_t);
+        team          = pool + uint64_t(header.poolSize) * sizeof(QChar);
+        size          = team + numPlayers * sizeof(uint8_t);
+    }
+
+    uint64_t hitting;
+    uint64_t pitching;
+    uint64_t fielding;
+    uint64_t age;
+    uint64_t experience;
+    uint64_t idString;
+    uint64_t nameString;
+    uint64_t stringOffsets;
+    uint64_t pool;
+    uint64_t team;
+    uint64_t size;
+};
+
+QByteArray FBBProjectionCache::HashSources(const QStringList& files)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString& file : files) {
+        QFile inputFile(file);
+        if (inputFile.open(QIODevice::ReadOnly)) {
+            hash.addData(&inputFile);
+        }
+        hash.addData(QByteArray(1, '\0'));
+    }
+    return hash.result();
+}
+
+QString FBBProjectionCache::SnapshotPath()
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return QDir(cacheDir).filePath("projections.fbbs");
+}
+
+bool FBBProjectionCache::Load(const QByteArray& hash, FBBPlayerStore& store)
+{
+    FBB_TRACE_SCOPE("FBBProjectionCache::Load");
+
+    // Map snapshot
+    QFile file(SnapshotPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    if (fileSize < qint64(sizeof(SnapshotHeader))) {
+        return false;
+    }
+
+    const char* pData = reinterpret_cast<const char*>(file.map(0, fileSize));
+    if (!pData) {
+        return false;
+    }
+
+    // Validate header
+    SnapshotHeader header;
+    memcpy(&header, pData, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION) {
+        return false;
+    }
+    if (hash.size() != int(sizeof(header.hash)) || memcmp(header.hash, hash.constData(), sizeof(header.hash)) != 0) {
+        return false;
+    }
+
+    const SnapshotLayout layout(header);
+    if (layout.size != uint64_t(fileSize)) {
+        return false;
+    }
+
+    const size_t numHitters = header.hitterCount;
+    const size_t numPitchers = header.pitcherCount;
+    const size_t numPlayers = numHitters + numPitchers;
+
+    const uint32_t* pHitting = reinterpret_cast<const uint32_t*>(pData + layout.hitting);
+    const uint32_t* pPitching = reinterpret_cast<const uint32_t*>(pData + layout.pitching);
+    const float* pFielding = reinterpret_cast<const float*>(pData + layout.fielding);
+    const uint32_t* pAge = reinterpret_cast<const uint32_t*>(pData + layout.age);
+    const uint32_t* pExperience = reinterpret_cast<const uint32_t*>(pData + layout.experience);
+    const uint32_t* pIdString = reinterpret_cast<const uint32_t*>(pData + layout.idString);
+    const uint32_t* pNameString = reinterpret_cast<const uint32_t*>(pData + layout.nameString);
+    const uint32_t* pStringOffsets = reinterpret_cast<const uint32_t*>(pData + layout.stringOffsets);
+    const QChar* pPool = reinterpret_cast<const QChar*>(pData + layout.pool);
+    const uint8_t* pTeam = reinterpret_cast<const uint8_t*>(pData + layout.team);
+
+    // Validate string table
+    for (uint32_t i = 0; i < header.stringCount; i++) {
+        if (pStringOffsets[i] > pStringOffsets[i + 1]) {
+            return false;
+        }
+    }
+    if (pStringOffsets[0] != 0 || pStringOffsets[header.stringCount] != header.poolSize) {
+        return false;
+    }
+    for (size_t i = 0; i < numPlayers; i++) {
+        if (pIdString[i] >= header.stringCount || pNameString[i] >= header.stringCount) {
+            return false;
+        }
+    }
+
+    auto GetString = [&](uint32_t index) {
+        const uint32_t offset = pStringOffsets[index];
+        return QString(pPool + offset, int(pStringOffsets[index + 1] - offset));
+    };
+
+    // Build players (hitters then pitchers, same order they were saved in)
+    auto LoadPartition = [&](FBBPlayer::PlayerType type, size_t first, size_t count, const uint32_t* pStats, size_t statCount) {
+
+        store.Reserve(type, uint32_t(count));
+        FBBPlayerColumns& columns = store.Columns(type);
+
+        for (size_t i = first; i < first + count; i++) {
+            FBBPlayer* pPlayer = store.Add(type, GetString(pIdString[i]), GetString(pNameString[i]));
+            pPlayer->Team() = FBBTeam(pTeam[i]);
+            pPlayer->Age() = pAge[i];
+            pPlayer->Experience() = pExperience[i];
+        }
+
+        // Columns are stored back to back so they copy straight across
+        for (size_t stat = 0; stat < statCount; stat++) {
+            memcpy(columns.stats[stat].data(), pStats + stat * count, count * sizeof(uint32_t));
+        }
+        for (size_t pos = 0; pos < FBBPlayer::Fielding_Count; pos++) {
+            memcpy(columns.fielding[pos].data(), pFielding + pos * numPlayers + first, count * sizeof(float));
+        }
+    };
+
+    LoadPartition(FBBPlayer::PLAYER_TYPE_HITTER, 0, numHitters, pHitting, FBBPlayer::HittingStats_Count);
+    LoadPartition(FBBPlayer::PLAYER_TYPE_PITCHER, numHitters, numPitchers, pPitching, FBBPlayer::PitchingStats_Count);
+    return true;
+}
+
+bool FBBProjectionCache::Save(const QByteArray& hash, const FBBPlayerStore& store)
+{
+    FBB_TRACE_SCOPE("FBBProjectionCache::Save");
+
+    if (hash.size() != int(sizeof(SnapshotHeader::hash))) {
+        return false;
+    }
+
+    const FBBPlayerColumns& hitters = store.Columns(FBBPlayer::PLAYER_TYPE_HITTER);
+    const FBBPlayerColumns& pitchers = store.Columns(FBBPlayer::PLAYER_TYPE_PITCHER);
+    const size_t numHitters = hitters.Count();
+    const size_t numPitchers = pitchers.Count();
+    const size_t numPlayers = numHitters + numPitchers;
+
+    // Intern ids and names
+    QHash<QString, uint32_t> mapStrings;
+    std::vector<uint32_t> vecOffsets = { 0 };
+    QString pool;
+    auto Intern = [&](const QString& str) {
+        auto itr = mapStrings.constFind(str);
+        if (itr != mapStrings.constEnd()) {
+            return itr.value();
+        }
+        const uint32_t index = uint32_t(vecOffsets.size() - 1);
+        pool += str;
+        vecOffsets.push_back(uint32_t(pool.size()));
+        mapStrings.insert(str, index);
+        return index;
+    };
+
+    std::vector<uint32_t> vecIdString;
+    std::vector<uint32_t> vecNameString;
+    vecIdString.reserve(numPlayers);
+    vecNameString.reserve(numPlayers);
+    for (const FBBPlayerColumns* pColumns : { &hitters, &pitchers }) {
+        const QChar* pPool = pColumns->pool.data();
+        const uint32_t* pOffsets = pColumns->stringOffsets.data();
+        for (uint32_t row = 0; row < pColumns->Count(); row++) {
+            const uint32_t idBegin = pOffsets[2 * row];
+            const uint32_t nameBegin = pOffsets[2 * row + 1];
+            const uint32_t nameEnd = pOffsets[2 * row + 2];
+            vecIdString.push_back(Intern(QString(pPool + idBegin, int(nameBegin - idBegin))));
+            vecNameString.push_back(Intern(QString(pPool + nameBegin, int(nameEnd - nameBegin))));
+        }
+    }
+
+    // Header
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    memcpy(header.hash, hash.constData(), sizeof(header.hash));
+    header.version = SNAPSHOT_VERSION;
+    header.hitterCount = uint32_t(numHitters);
+    header.pitcherCount = uint32_t(numPitchers);
+    header.stringCount = uint32_t(vecOffsets.size() - 1);
+    header.poolSize = uint32_t(pool.size());
+
+    const SnapshotLayout layout(header);
+    QByteArray data(int(layout.size), '\0');
+    char* pData = data.data();
+    memcpy(pData, &header, sizeof(header));
+
+    // Stat columns
+    for (size_t stat = 0; stat < FBBPlayer::HittingStats_Count; stat++) {
+        memcpy(pData + layout.hitting + stat * numHitters * sizeof(uint32_t), hitters.stats[stat].data(), numHitters * sizeof(uint32_t));
+    }
+    for (size_t stat = 0; stat < FBBPlayer::PitchingStats_Count; stat++) {
+        memcpy(pData + layout.pitching + stat * numPitchers * sizeof(uint32_t), pitchers.stats[stat].data(), numPitchers * sizeof(uint32_t));
+    }
+
+    // Player columns (hitters then pitchers)
+    float* pFielding = reinterpret_cast<float*>(pData + layout.fielding);
+    uint32_t* pAge = reinterpret_cast<uint32_t*>(pData + layout.age);
+    uint32_t* pExperience = reinterpret_cast<uint32_t*>(pData + layout.experience);
+    uint8_t* pTeam = reinterpret_cast<uint8_t*>(pData + layout.team);
+
+    size_t first = 0;
+    for (const FBBPlayerColumns* pColumns : { &hitters, &pitchers }) {
+        const size_t count = pColumns->Count();
+        for (size_t pos = 0; pos < FBBPlayer::Fielding_Count; pos++) {
+            memcpy(pFielding + pos * numPlayers + first, pColumns->fielding[pos].data(), count * sizeof(float));
+        }
+        memcpy(pAge + first, pColumns->age.data(), count * sizeof(uint32_t));
+        memcpy(pExperience + first, pColumns->experience.data(), count * sizeof(uint32_t));
+        for (size_t i = 0; i < count; i++) {
+            pTeam[first + i] = uint8_t(pColumns->team[i]);
+        }
+        first += count;
+    }
+
+    // String table
+    memcpy(pData + layout.idString, vecIdString.data(), vecIdString.size() * sizeof(uint32_t));
+    memcpy(pData + layout.nameString, vecNameString.data(), vecNameString.size() * sizeof(uint32_t));
+    memcpy(pData + layout.stringOffsets, vecOffsets.data(), vecOffsets.size() * sizeof(uint32_t));
+    memcpy(pData + layout.pool, pool.constData(), size_t(pool.size()) * sizeof(QChar));
+
+    // Write atomically so a crash never leaves a half written snapshot
+    const QString path = SnapshotPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
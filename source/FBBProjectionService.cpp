@@ -3,16 +3,26 @@
 #include "FBB/FBBLeaugeSettings.h"
 #include "FBB/FBBApplication.h"
 #include "FBB/FBBDraftBoardModel.h"
+#include "FBB/FBBCSVReader.h"
+#include "FBB/FBBProjectionCache.h"
+#include "FBB/FBBPlayerStore.h"
+#include "FBB/FBBTrace.h"
 
 #include <QApplication>
+#include <QDir>
 #include <QFile>
-#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include <memory>
+#include <algorithm>
+#include <iterator>
+#include <utility>
 
-static FBBTeam ToFBBTeam(const QString& teamName)
+static FBBTeam ToFBBTeam(const FBBCSVField& teamName)
 {
-    static const QMap<QString, FBBTeam> s_LUT =
+    // Sorted by name so we can binary search
+    static const std::pair<const char*, FBBTeam> s_LUT[] =
     {
         { "Angels", FBBTeam::LAA },
         { "Astros", FBBTeam::HOU },
@@ -47,30 +57,148 @@ static FBBTeam ToFBBTeam(const QString& teamName)
     };
 
     // Assume no team is a free agent
-    if (teamName.isEmpty()) {
+    if (teamName.IsEmpty()) {
         return FBBTeam::FA;
     }
 
     // Lookup from string
-    auto itr = s_LUT.find(teamName);
-    if (itr == s_LUT.end()) {
+    auto itr = std::lower_bound(std::begin(s_LUT), std::end(s_LUT), teamName, [](const auto& entry, const FBBCSVField& name) {
+        return name.Compare(entry.first) > 0;
+    });
+    if (itr == std::end(s_LUT) || teamName != itr->first) {
         return FBBTeam::FA;
     }
-    return itr.value();
+    return itr->second;
 }
 
-void FBBProjectionService::LoadHittingProjections(std::vector<FBBPlayer*>& vecPlayers, const QString& file)
+//------------------------------------------------------------------------------
+// MappedFile
+//------------------------------------------------------------------------------
+// Memory-maps a file for reading. Uncompressed Qt resources are mapped in place;
+// anything that cannot be mapped is read into memory instead.
+class MappedFile
 {
-    // Open file
-    QFile inputFile(file);
-    inputFile.open(QIODevice::ReadOnly);
-    QTextStream textStream(&inputFile);
+public:
+    MappedFile(const QString& file)
+        : m_file(file)
+    {
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            return;
+        }
 
-    // Tokenize header data
-    QStringList parsed = textStream.readLine().split(",");
-    parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+        const qint64 size = m_file.size();
+        if (const uchar* pData = size > 0 ? m_file.map(0, size) : nullptr) {
+            m_pBegin = reinterpret_cast<const char*>(pData);
+            m_pEnd = m_pBegin + size;
+        } else {
+            m_buffer = m_file.readAll();
+            m_pBegin = m_buffer.constData();
+            m_pEnd = m_pBegin + m_buffer.size();
+        }
+    }
+
+    const char* Begin() const { return m_pBegin; }
+    const char* End() const { return m_pEnd; }
+
+private:
+    QFile m_file;
+    QByteArray m_buffer;
+    const char* m_pBegin = nullptr;
+    const char* m_pEnd = nullptr;
+};
+
+// Parses the rows of [pBegin, pEnd) in row aligned chunks on the global thread
+// pool. Results are merged back in input order.
+template <typename T, typename ParseRow>
+static std::vector<T> ParseRows(const char* pBegin, const char* pEnd, size_t chunkCount, const ParseRow& parseRow)
+{
+    struct Chunk
+    {
+        FBBCSVReader::Range range;
+        std::vector<T> rows;
+    };
+
+    std::vector<Chunk> vecChunks;
+    for (const FBBCSVReader::Range& range : FBBCSVReader::SplitRows(pBegin, pEnd, chunkCount)) {
+        vecChunks.push_back({ range, {} });
+    }
+
+    auto ParseChunk = [&](Chunk& chunk) {
+        FBB_TRACE_SCOPE("ParseRows chunk");
+        FBBCSVReader reader(chunk.range.first, chunk.range.second);
+        while (reader.ReadRow()) {
+            chunk.rows.push_back(parseRow(reader));
+        }
+    };
+
+    // Don't bother with the pool for a single chunk
+    if (vecChunks.size() == 1) {
+        ParseChunk(vecChunks.front());
+    } else {
+        QtConcurrent::blockingMap(vecChunks, ParseChunk);
+    }
+
+    // Merge
+    size_t count = 0;
+    for (const Chunk& chunk : vecChunks) {
+        count += chunk.rows.size();
+    }
+
+    std::vector<T> ret;
+    ret.reserve(count);
+    for (Chunk& chunk : vecChunks) {
+        std::move(chunk.rows.begin(), chunk.rows.end(), std::back_inserter(ret));
+    }
+    return ret;
+}
+
+// Player parsed on the pool, before it is appended to the store
+template <size_t StatCount>
+struct ParsedPlayer
+{
+    QString id;
+    QString name;
+    FBBTeam team;
+    uint32_t stats[StatCount];
+};
+
+template <size_t StatCount>
+static void AddPlayers(FBBPlayerStore& store, FBBPlayer::PlayerType type, const std::vector<ParsedPlayer<StatCount>>& vecParsed)
+{
+    store.Reserve(type, static_cast<uint32_t>(vecParsed.size()));
+    for (const ParsedPlayer<StatCount>& parsed : vecParsed) {
+        FBBPlayer* pPlayer = store.Add(type, parsed.id, parsed.name);
+        pPlayer->Team() = parsed.team;
+
+        FBBPlayerColumns& columns = store.Columns(type);
+        for (size_t stat = 0; stat < StatCount; stat++) {
+            columns.stats[stat][pPlayer->Row()] = parsed.stats[stat];
+        }
+    }
+}
+
+size_t FBBProjectionService::ChunkCount(const char* pBegin, const char* pEnd) const
+{
+    if (m_loadMode == LoadMode::Serial) {
+        return 1;
+    }
+
+    // Keep chunks big enough to be worth a trip through the pool
+    static const size_t MIN_CHUNK_BYTES = 64 * 1024;
+    const size_t bytes = static_cast<size_t>(pEnd - pBegin);
+    const size_t maxChunks = static_cast<size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount())) * 4;
+    return std::max<size_t>(1, std::min(maxChunks, bytes / MIN_CHUNK_BYTES));
+}
+
+void FBBProjectionService::LoadHittingProjections(FBBPlayerStore& store, const QString& file)
+{
+    FBB_TRACE_SCOPE("FBBProjectionService::LoadHittingProjections");
+
+    // Map file and skip the header
+    MappedFile mappedFile(file);
+    FBBCSVReader header(mappedFile.Begin(), mappedFile.End());
+    header.ReadRow();
 
-    // Stats to find
     // Stats to find
     enum FanHitter
     {
@@ -105,47 +233,46 @@ void FBBProjectionService::LoadHittingProjections(std::vector<FBBPlayer*>& vecPl
     // Rk,Name,Age,PA,AB,R,H,2B,3B,HR,RBI,SB,CS,BB,SO,BA,OBP,SLG,OPS,TB,GDP,HBP,SH,SF,IBB,Rel
     // 1,Jose Abreu\abreujo02,32,544,492,65,136,31,2,21,75,2,1,35,106,.276,.335,.476,.811,234,15,11,0,5,5,86%
 
-    // Loop rows
-    while (!textStream.atEnd()) {
-
-        // Tokenize this row
-        QStringList parsed = textStream.readLine().split(",");
-        parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    // Parse rows
+    using ParsedHitter = ParsedPlayer<FBBPlayer::HittingStats_Count>;
+    const char* pBody = header.Position();
+    std::vector<ParsedHitter> vecParsed = ParseRows<ParsedHitter>(pBody, mappedFile.End(), ChunkCount(pBody, mappedFile.End()), [](const FBBCSVReader& reader) {
 
-        // Lazily get player
-        FBBPlayer* pPlayer = new FBBPlayer(FBBPlayer::PLAYER_TYPE_HITTER, parsed[FAN_HITTER_PLAYER_ID], parsed[FAN_HITTER_NAME], this);
-        pPlayer->team = ToFBBTeam(parsed[FAN_HITTER_TEAM]);
+        ParsedHitter parsed;
+        parsed.id = reader[FAN_HITTER_PLAYER_ID].ToString();
+        parsed.name = reader[FAN_HITTER_NAME].ToString();
+        parsed.team = ToFBBTeam(reader[FAN_HITTER_TEAM]);
 
         // Load stats
-        pPlayer->projection.hitting.PA =  parsed[FAN_HITTER_PA].toUInt();
-        pPlayer->projection.hitting.AB =  parsed[FAN_HITTER_AB].toUInt();
-        pPlayer->projection.hitting.H =   parsed[FAN_HITTER_H].toUInt();
-        pPlayer->projection.hitting._2B = parsed[FAN_HITTER_2B].toUInt();
-        pPlayer->projection.hitting._3B = parsed[FAN_HITTER_3B].toUInt();
-        pPlayer->projection.hitting.HR =  parsed[FAN_HITTER_HR].toUInt();
-        pPlayer->projection.hitting.R =   parsed[FAN_HITTER_R].toUInt();
-        pPlayer->projection.hitting.RBI = parsed[FAN_HITTER_RBI].toUInt();
-        pPlayer->projection.hitting.BB =  parsed[FAN_HITTER_BB].toUInt();
-        pPlayer->projection.hitting.SO =  parsed[FAN_HITTER_SO].toUInt();
-        pPlayer->projection.hitting.HBP = parsed[FAN_HITTER_HBP].toUInt();
-        pPlayer->projection.hitting.SB =  parsed[FAN_HITTER_SB].toUInt();
-        pPlayer->projection.hitting.CS =  parsed[FAN_HITTER_CS].toUInt();
-
-        // Add player
-        vecPlayers.push_back(pPlayer);
-    }
+        parsed.stats[FBBPlayer::HITTING_STAT_PA] =  reader[FAN_HITTER_PA].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_AB] =  reader[FAN_HITTER_AB].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_H] =   reader[FAN_HITTER_H].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_2B] =  reader[FAN_HITTER_2B].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_3B] =  reader[FAN_HITTER_3B].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_HR] =  reader[FAN_HITTER_HR].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_R] =   reader[FAN_HITTER_R].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_RBI] = reader[FAN_HITTER_RBI].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_BB] =  reader[FAN_HITTER_BB].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_SO] =  reader[FAN_HITTER_SO].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_HBP] = reader[FAN_HITTER_HBP].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_SB] =  reader[FAN_HITTER_SB].ToUInt();
+        parsed.stats[FBBPlayer::HITTING_STAT_CS] =  reader[FAN_HITTER_CS].ToUInt();
+
+        return parsed;
+    });
+
+    // Append to the hitter partition
+    AddPlayers(store, FBBPlayer::PLAYER_TYPE_HITTER, vecParsed);
 }
 
-void FBBProjectionService::LoadPitchingProjections(std::vector<FBBPlayer*>& vecPlayers, const QString& file)
+void FBBProjectionService::LoadPitchingProjections(FBBPlayerStore& store, const QString& file)
 {
-    // Open file
-    QFile inputFile(file);
-    inputFile.open(QIODevice::ReadOnly);
-    QTextStream textStream(&inputFile);
+    FBB_TRACE_SCOPE("FBBProjectionService::LoadPitchingProjections");
 
-    // Tokenize header data
-    QStringList parsed = textStream.readLine().split(",");
-    parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+    // Map file and skip the header
+    MappedFile mappedFile(file);
+    FBBCSVReader header(mappedFile.Begin(), mappedFile.End());
+    header.ReadRow();
 
     enum FanPitcher
     {
@@ -173,68 +300,52 @@ void FBBProjectionService::LoadPitchingProjections(std::vector<FBBPlayer*>& vecP
         FAN_PITCHER_PLAYER_ID,
     };
 
-    // Loop rows
-    while (!textStream.atEnd()) {
+    // Parse rows
+    using ParsedPitcher = ParsedPlayer<FBBPlayer::PitchingStats_Count>;
+    const char* pBody = header.Position();
+    std::vector<ParsedPitcher> vecParsed = ParseRows<ParsedPitcher>(pBody, mappedFile.End(), ChunkCount(pBody, mappedFile.End()), [](const FBBCSVReader& reader) {
 
-        // Tokenize this row
-        QStringList parsed = textStream.readLine().split(",");
-        parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
+        ParsedPitcher parsed;
+        parsed.id = reader[FAN_PITCHER_PLAYER_ID].ToString();
+        parsed.name = reader[FAN_PITCHER_NAME].ToString();
+        parsed.team = ToFBBTeam(reader[FAN_PITCHER_TEAM]);
 
-        // Lazily get player
-        FBBPlayer* pPlayer = new FBBPlayer(FBBPlayer::PLAYER_TYPE_PITCHER, parsed[FAN_PITCHER_PLAYER_ID], parsed[FAN_PITCHER_NAME], this);
-        pPlayer->team = ToFBBTeam(parsed[FAN_PITCHER_TEAM]);
-        
         // Load stats
-        pPlayer->projection.pitching.W =  parsed[FAN_PITCHER_W].toUInt();
-        pPlayer->projection.pitching.L =  parsed[FAN_PITCHER_L].toUInt();
-        pPlayer->projection.pitching.GS = parsed[FAN_PITCHER_GS].toUInt();
-        pPlayer->projection.pitching.G =  parsed[FAN_PITCHER_G].toUInt();
-        pPlayer->projection.pitching.SV = parsed[FAN_PITCHER_SV].toUInt();
-        pPlayer->projection.pitching.IP = parsed[FAN_PITCHER_IP].toFloat();
-        pPlayer->projection.pitching.H =  parsed[FAN_PITCHER_H].toUInt();
-        pPlayer->projection.pitching.ER = parsed[FAN_PITCHER_ER].toUInt();
-        pPlayer->projection.pitching.HR = parsed[FAN_PITCHER_HR].toUInt();
-        pPlayer->projection.pitching.SO = parsed[FAN_PITCHER_SO].toUInt();
-        pPlayer->projection.pitching.BB = parsed[FAN_PITCHER_BB].toUInt();
-
-        // Add player
-        vecPlayers.push_back(pPlayer);
-    }
-}
-
-static FBBPlayer* GetPlayerFromSortedById(const std::vector<FBBPlayer*>& vecPlayers, const FBBPlayerId& playerId)
-{
-    // Lookup player
-    auto itr = std::lower_bound(vecPlayers.begin(), vecPlayers.end(), playerId, [](auto& lhs, auto& rhs){
-        return lhs->id < rhs;
+        parsed.stats[FBBPlayer::PITCHING_STAT_W] =  reader[FAN_PITCHER_W].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_L] =  reader[FAN_PITCHER_L].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_GS] = reader[FAN_PITCHER_GS].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_G] =  reader[FAN_PITCHER_G].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_SV] = reader[FAN_PITCHER_SV].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_IP] = static_cast<uint32_t>(reader[FAN_PITCHER_IP].ToFloat());
+        parsed.stats[FBBPlayer::PITCHING_STAT_H] =  reader[FAN_PITCHER_H].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_ER] = reader[FAN_PITCHER_ER].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_HR] = reader[FAN_PITCHER_HR].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_SO] = reader[FAN_PITCHER_SO].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_BB] = reader[FAN_PITCHER_BB].ToUInt();
+        parsed.stats[FBBPlayer::PITCHING_STAT_HLD] = reader[FAN_PITCHER_HLD].ToUInt();
+
+        return parsed;
     });
 
-    if (itr == vecPlayers.end()) {
-        return nullptr;
-    } 
-    
-    if ((*itr)->id == playerId) {
-        return (*itr);
-    }
-
-    return nullptr;
+    // Append to the pitcher partition
+    AddPlayers(store, FBBPlayer::PLAYER_TYPE_PITCHER, vecParsed);
 }
 
-static void LoadFielding(std::vector<FBBPlayer*> vecPlayers, const QString& file)
+struct FBBProjectionService::FieldingRow
 {
-    // Open file
-    QFile inputFile(":/data/2019-appearances.csv");
-    inputFile.open(QIODevice::ReadOnly);
-    QTextStream textStream(&inputFile);
-
-    // Tokenize header data
-    QStringList parsed = textStream.readLine().split(",");
-    parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
-
-    // Sort by ID so we can binary search
-    std::sort(vecPlayers.begin(), vecPlayers.end(), [](const FBBPlayer* pLHS, const FBBPlayer* pRHS){
-        return pLHS->id < pRHS->id;
-    });
+    QByteArray id;
+    FBBPlayer::Fielding position;
+    float count;
+};
+
+std::vector<FBBProjectionService::FieldingRow> FBBProjectionService::LoadFielding(const QString& file)
+{
+    FBB_TRACE_SCOPE("FBBProjectionService::LoadFielding");
+
+    // Map file and skip the header
+    MappedFile mappedFile(file);
+    FBBCSVReader header(mappedFile.Begin(), mappedFile.End());
+    header.ReadRow();
 
     enum
     {
@@ -267,24 +378,11 @@ static void LoadFielding(std::vector<FBBPlayer*> vecPlayers, const QString& file
         APPEARANCE_PLAYERID,
     };
 
-    // Loop rows
-    while (!textStream.atEnd()) {
-
-        // Tokenize this row
-        QStringList parsed = textStream.readLine().split(",");
-        parsed.replaceInStrings("\"", "", Qt::CaseInsensitive);
-
-        QString id = parsed[APPEARANCE_PLAYERID];
-
-        FBBPlayer* pPlayer = GetPlayerFromSortedById(vecPlayers, id);
-        if (!pPlayer) {
-            continue;
-        }
-
-        const QString pos = parsed[APPEARANCE_POS];
-        const float count = parsed[APPEARANCE_INN].toFloat();
+    // Parse rows
+    const char* pBody = header.Position();
+    return ParseRows<FieldingRow>(pBody, mappedFile.End(), ChunkCount(pBody, mappedFile.End()), [](const FBBCSVReader& reader) {
 
-        static std::map<QString, FBBPlayer::Fielding> s_LUT = 
+        static const std::pair<const char*, FBBPlayer::Fielding> s_LUT[] =
         {
             { "C", FBBPlayer::FIELDING_C},
             { "1B", FBBPlayer::FIELDING_1B},
@@ -296,49 +394,54 @@ static void LoadFielding(std::vector<FBBPlayer*> vecPlayers, const QString& file
             { "RF", FBBPlayer::FIELDING_RF},
         };
 
-        auto itr = s_LUT.find(pos);
-        if (itr == s_LUT.end()) {
+        const FBBCSVField& pos = reader[APPEARANCE_POS];
+        auto itr = std::find_if(std::begin(s_LUT), std::end(s_LUT), [&](const auto& entry) {
+            return pos == entry.first;
+        });
+
+        FieldingRow row;
+        const FBBCSVField& id = reader[APPEARANCE_PLAYERID];
+        row.id = QByteArray(id.Data(), int(id.Size()));
+        row.position = itr == std::end(s_LUT) ? FBBPlayer::Fielding_Count : itr->second;
+        row.count = reader[APPEARANCE_INN].ToFloat();
+        return row;
+    });
+}
+
+void FBBProjectionService::JoinFielding(const FBBPlayerRegistry& registry, const std::vector<FieldingRow>& vecRows)
+{
+    FBB_TRACE_SCOPE("FBBProjectionService::JoinFielding");
+
+    // Join with players (in file order so sums are deterministic)
+    for (const FieldingRow& row : vecRows) {
+
+        // Two-way players field as hitters
+        const FBBPlayerHandle handle = registry.Find(row.id);
+        FBBPlayer* pPlayer = registry.Player(handle, FBBPlayer::PLAYER_TYPE_HITTER);
+        if (!pPlayer) {
+            pPlayer = registry.Player(handle, FBBPlayer::PLAYER_TYPE_PITCHER);
+        }
+        if (!pPlayer) {
             continue;
         }
 
-        switch (itr->second)
-        {
-        case FBBPlayer::FIELDING_C:
-            pPlayer->appearances.fielding.C += count;
-            break;
-        case FBBPlayer::FIELDING_1B:
-            pPlayer->appearances.fielding._1B += count;
-            break;
-        case FBBPlayer::FIELDING_2B:
-            pPlayer->appearances.fielding._2B += count;
-            break;
-        case FBBPlayer::FIELDING_SS:
-            pPlayer->appearances.fielding.SS += count;
-            break;
-        case FBBPlayer::FIELDING_3B:
-            pPlayer->appearances.fielding._3B += count;
-            break;
-        case FBBPlayer::FIELDING_LF:
-            pPlayer->appearances.fielding.LF += count;
-            break;
-        case FBBPlayer::FIELDING_CF:
-            pPlayer->appearances.fielding.CF += count;
-            break;
-        case FBBPlayer::FIELDING_RF:
-            pPlayer->appearances.fielding.RF += count;
-            break;
-        default:
-            break;
+        if (row.position != FBBPlayer::Fielding_Count) {
+            pPlayer->Appearances(row.position) += row.count;
         }
     }
 }
 
 FBBProjectionService::FBBProjectionService(QObject* parent)
     : QObject(parent)
+    , m_pWatcher(new QFutureWatcher<LoadResult>(this))
 {
-    LoadProjections();
+    connect(m_pWatcher, &QFutureWatcherBase::finished, this, &FBBProjectionService::OnPlayersLoaded);
 }
 
+const char* const FBBProjectionService::HITTING_FILE_NAME = "hitters.csv";
+const char* const FBBProjectionService::PITCHING_FILE_NAME = "pitchers.csv";
+const char* const FBBProjectionService::APPEARANCE_FILE_NAME = "appearances.csv";
+
 FBBProjectionService& FBBProjectionService::Instance()
 {
     static FBBProjectionService* s_service = new FBBProjectionService(qApp);
@@ -347,14 +450,101 @@ FBBProjectionService& FBBProjectionService::Instance()
 
 void FBBProjectionService::LoadProjections()
 {
-    const QString hittingFile = ":/data/2019-hitters-fan.csv";
-    const QString pitchingFile = ":/data/2019-pitchers-fan.csv";
-    const QString appearanceFile = ":/data/2019-appearances.csv";
+    if (m_loading) {
+        return;
+    }
+    m_loading = true;
+
+    m_pWatcher->setFuture(QtConcurrent::run([=]() {
+        return LoadPlayers();
+    }));
+}
+
+FBBProjectionService::LoadResult FBBProjectionService::LoadPlayers()
+{
+    // The load itself runs here, on the pool
+    FBB_TRACE_SCOPE("FBBProjectionService::LoadProjections");
+
+    const bool isBundled = m_sourceDirectory.isEmpty();
+    const QDir sourceDir(m_sourceDirectory);
+    const QString hittingFile = isBundled ? ":/data/2019-hitters-fan.csv" : sourceDir.filePath(HITTING_FILE_NAME);
+    const QString pitchingFile = isBundled ? ":/data/2019-pitchers-fan.csv" : sourceDir.filePath(PITCHING_FILE_NAME);
+    const QString appearanceFile = isBundled ? ":/data/2019-appearances.csv" : sourceDir.filePath(APPEARANCE_FILE_NAME);
+
+    // Snapshot is keyed on the contents of the source files
+    emit LoadProgress(tr("Checking projection cache..."));
+    const QByteArray hash = FBBProjectionCache::HashSources({ hittingFile, pitchingFile, appearanceFile });
+
+    LoadResult result;
+    result.spStore = std::make_shared<FBBPlayerStore>();
+    FBBPlayerStore& store = *result.spStore;
+
+    if (FBBProjectionCache::Load(hash, store)) {
+        for (FBBPlayer* pPlayer : store.Players()) {
+            result.registry.Register(pPlayer);
+        }
+        return result;
+    }
+
+    // Only parse if the snapshot is missing or stale. Hitters and pitchers live
+    // in separate partitions of the store so they can be filled concurrently.
+    emit LoadProgress(tr("Loading projections..."));
+
+    auto LoadHitters = [&]() {
+        LoadHittingProjections(store, hittingFile);
+        emit LoadProgress(tr("Loaded %1 hitters").arg(store.Count(FBBPlayer::PLAYER_TYPE_HITTER)));
+    };
+    auto LoadPitchers = [&]() {
+        LoadPitchingProjections(store, pitchingFile);
+        emit LoadProgress(tr("Loaded %1 pitchers").arg(store.Count(FBBPlayer::PLAYER_TYPE_PITCHER)));
+    };
+    auto LoadAppearances = [&]() {
+        std::vector<FieldingRow> vecRows = LoadFielding(appearanceFile);
+        emit LoadProgress(tr("Loaded %1 appearances").arg(vecRows.size()));
+        return vecRows;
+    };
+
+    std::vector<FieldingRow> vecFielding;
+    if (m_loadMode == LoadMode::Serial) {
+        LoadHitters();
+        LoadPitchers();
+        vecFielding = LoadAppearances();
+    } else {
+        QFuture<void> hitters = QtConcurrent::run(LoadHitters);
+        QFuture<void> pitchers = QtConcurrent::run(LoadPitchers);
+        QFuture<std::vector<FieldingRow>> fielding = QtConcurrent::run(LoadAppearances);
+        hitters.waitForFinished();
+        pitchers.waitForFinished();
+        vecFielding = fielding.result();
+    }
+
+    // Hitters then pitchers so handles come out in a stable order
+    for (FBBPlayer* pPlayer : store.Players()) {
+        result.registry.Register(pPlayer);
+    }
+    JoinFielding(result.registry, vecFielding);
+
+    emit LoadProgress(tr("Caching projections..."));
+    FBBProjectionCache::Save(hash, store);
+
+    return result;
+}
+
+void FBBProjectionService::OnPlayersLoaded()
+{
+    FBB_TRACE_SCOPE("FBBProjectionService::OnPlayersLoaded");
+
+    // Keep the previous store alive until the model has let go of its views
+    std::shared_ptr<FBBPlayerStore> spPrevious = m_spStore;
+
+    LoadResult result = m_pWatcher->result();
+    m_spStore = result.spStore;
+    m_registry = std::move(result.registry);
 
-    std::vector<FBBPlayer*> vecPlayers;
-    FBBProjectionService::LoadHittingProjections(vecPlayers, hittingFile);
-    FBBProjectionService::LoadPitchingProjections(vecPlayers, pitchingFile);
-    LoadFielding(vecPlayers, pitchingFile);
+    emit LoadProgress(tr("Calculating values..."));
+    fbbApp->DraftBoardModel()->Reset(m_spStore.get());
 
-    fbbApp->DraftBoardModel()->Reset(vecPlayers);
+    m_loading = false;
+    m_loaded = true;
+    emit ProjectionsLoaded();
 }
@@ -0,0 +1,58 @@
+#include "FBB/FBBRenderCache.h"
+
+#include <algorithm>
+
+void FBBRenderCache::Reset(size_t rows, size_t columns)
+{
+    m_epoch = 1;
+    m_columns = columns;
+    m_vecRowEpoch.assign(rows, m_epoch);
+    m_vecColumnEpoch.assign(columns, m_epoch);
+    m_vecRows.clear();
+    m_vecRows.resize(rows);
+}
+
+void FBBRenderCache::InvalidateRows(size_t first, size_t last)
+{
+    m_epoch++;
+    for (size_t row = first; row <= last && row < m_vecRowEpoch.size(); row++) {
+        m_vecRowEpoch[row] = m_epoch;
+    }
+}
+
+void FBBRenderCache::InvalidateColumns(size_t first, size_t last)
+{
+    m_epoch++;
+    for (size_t column = first; column <= last && column < m_columns; column++) {
+        m_vecColumnEpoch[column] = m_epoch;
+    }
+}
+
+const QVariant* FBBRenderCache::Find(size_t row, size_t column, Slot slot) const
+{
+    if (row >= m_vecRows.size() || column >= m_columns || !m_vecRows[row]) {
+        return nullptr;
+    }
+
+    const Cell& cell = m_vecRows[row][column * Slot_Count + slot];
+    if (cell.epoch < std::max(m_vecRowEpoch[row], m_vecColumnEpoch[column])) {
+        return nullptr;
+    }
+    return &cell.value;
+}
+
+void FBBRenderCache::Store(size_t row, size_t column, Slot slot, const QVariant& value)
+{
+    if (row >= m_vecRows.size() || column >= m_columns) {
+        return;
+    }
+
+    std::unique_ptr<Cell[]>& spRow = m_vecRows[row];
+    if (!spRow) {
+        spRow.reset(new Cell[m_columns * Slot_Count]);
+    }
+
+    Cell& cell = spRow[column * Slot_Count + slot];
+    cell.epoch = m_epoch;
+    cell.value = value;
+}
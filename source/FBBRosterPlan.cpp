@@ -0,0 +1,180 @@
+#include "FBB/FBBRosterPlan.h"
+#include "FBB/FBBApplication.h"
+#include "FBB/FBBDraftBoardModel.h"
+#include "FBB/FBBPlayer.h"
+
+#include <QVBoxLayout>
+#include <QComboBox>
+#include <QLabel>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QSignalBlocker>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+
+// Search time per replan (the plan is redone on every pick and price update)
+static const double FRAME_BUDGET_MS = 10.0;
+
+FBBRosterPlan::FBBRosterPlan(QWidget* pParent)
+    : QWidget(pParent)
+{
+    // Main layout
+    QVBoxLayout* pLayout = new QVBoxLayout(this);
+    pLayout->setContentsMargins(0, 0, 0, 0);
+
+    m_pOwner = new QComboBox(this);
+    m_pSummary = new QLabel(this);
+    m_pSummary->setWordWrap(true);
+    pLayout->addWidget(new QLabel("Plan for:", this));
+    pLayout->addWidget(m_pOwner);
+    pLayout->addWidget(m_pSummary);
+
+    m_pTable = new QTableWidget(0, 4, this);
+    m_pTable->setHorizontalHeaderLabels(QStringList() << "Name" << "Pos." << "$" << "Value");
+    m_pTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_pTable->setSelectionMode(QAbstractItemView::NoSelection);
+    m_pTable->verticalHeader()->hide();
+    m_pTable->verticalHeader()->setDefaultSectionSize(15);
+    m_pTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_pTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    m_pTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+    m_pTable->horizontalHeader()->setSectionResizeMode(3, QHeaderView::ResizeToContents);
+    pLayout->addWidget(m_pTable, 1);
+    setMinimumWidth(260);
+
+    // Bursts of changes replan once
+    m_pReplanTimer = new QTimer(this);
+    m_pReplanTimer->setSingleShot(true);
+    m_pReplanTimer->setInterval(0);
+    connect(m_pReplanTimer, &QTimer::timeout, this, [this]() {
+        Replan();
+    });
+
+    // A different owner's plan is no warm start
+    connect(m_pOwner, static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, [this](int) {
+        m_planner.Clear();
+        ScheduleReplan();
+    });
+
+    // Replan on picks, loads and new simulated prices. A pick or a load
+    // signals several times, so these only schedule one replan.
+    FBBDraftBoardModel* pModel = fbbApp->DraftBoardModel();
+    connect(pModel, &FBBDraftBoardModel::PlayerDrafted, this, [this](FBBPlayer*) {
+        ScheduleReplan();
+    });
+    connect(pModel, &FBBDraftBoardModel::DraftLoaded, this, [this]() {
+        ScheduleReplan();
+    });
+    connect(pModel, &FBBDraftBoardModel::dataChanged, this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+        if (topLeft.column() <= FBBDraftBoardModel::COLUMN_MARKET && bottomRight.column() >= FBBDraftBoardModel::COLUMN_MARKET) {
+            ScheduleReplan();
+        }
+    });
+    connect(pModel, &FBBDraftBoardModel::modelReset, this, [this]() {
+        m_planner.Clear();
+        ScheduleReplan();
+    });
+
+    Replan();
+}
+
+void FBBRosterPlan::UpdateOwners()
+{
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+
+    // Only rebuild when the owners change so the selection sticks
+    bool same = m_pOwner->count() == int(pSettings->owners.size());
+    int index = 0;
+    for (auto itr = pSettings->owners.begin(); same && itr != pSettings->owners.end(); ++itr, ++index) {
+        same = m_pOwner->itemData(index).toULongLong() == itr->first && m_pOwner->itemText(index) == itr->second->name;
+    }
+    if (same) {
+        return;
+    }
+
+    const QSignalBlocker blocker(m_pOwner);
+    const FBBOwnerId current = m_pOwner->currentData().toULongLong();
+    m_pOwner->clear();
+    for (const auto& owner : pSettings->owners) {
+        m_pOwner->addItem(owner.second->name, QVariant::fromValue<qulonglong>(owner.first));
+        if (owner.first == current) {
+            m_pOwner->setCurrentIndex(m_pOwner->count() - 1);
+        }
+    }
+    m_planner.Clear();
+}
+
+void FBBRosterPlan::ScheduleReplan()
+{
+    if (!m_pReplanTimer->isActive()) {
+        m_pReplanTimer->start();
+    }
+}
+
+void FBBRosterPlan::Replan()
+{
+    UpdateOwners();
+
+    FBBDraftBoardModel* pModel = fbbApp->DraftBoardModel();
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+    const FBBOwnerId owner = m_pOwner->currentData().toULongLong();
+    m_pTable->setRowCount(0);
+    if (!owner || pModel->PlayerCount() == 0) {
+        m_pSummary->clear();
+        return;
+    }
+
+    // The owner's players hold their slots and money; everyone undrafted and
+    // worth something is a candidate at their expected price
+    std::vector<FBBRosterSlots::Slot> vecSlots = FBBTeamSlots(*pSettings, FBBPlayer::PLAYER_TYPE_HITTER);
+    for (const FBBRosterSlots::Slot& slot : FBBTeamSlots(*pSettings, FBBPlayer::PLAYER_TYPE_PITCHER)) {
+        vecSlots.push_back(slot);
+    }
+    FBBRosterSlots roster(vecSlots);
+    int64_t budget = pSettings->leauge.budget;
+    std::vector<FBBRosterPlanner::Candidate> vecCandidates;
+    for (uint32_t i = 0; i < pModel->PlayerCount(); i++) {
+        const FBBPlayer* pPlayer = pModel->GetPlayer(i);
+        if (pPlayer->Owner() == owner) {
+            budget -= pPlayer->Paid();
+            const FBBPositionMask drafted = pPlayer->DraftPosition();
+            roster.Place(i, drafted != FBB_POSITION_UNKNOWN ? drafted : pPlayer->EligablePositions());
+        } else if (pPlayer->Owner() == 0 && pPlayer->IsValidUnderCurrentSettings()) {
+            const float value = pPlayer->Estimate();
+            if (value > 0.f) {
+                const float price = pPlayer->MarketPrice() > 0.f ? pPlayer->MarketPrice() : value;
+                vecCandidates.push_back({ i, pPlayer->EligablePositions(), uint32_t(std::ceil(std::max(1.f, price))), value });
+            }
+        }
+    }
+
+    const FBBRosterPlanner::Plan& plan = m_planner.Solve(roster, uint32_t(std::max<int64_t>(0, budget)), vecCandidates, FRAME_BUDGET_MS);
+
+    m_pSummary->setText(QString("$%1 of $%2 on %3 players for $%4 of value%5")
+        .arg(plan.cost)
+        .arg(std::max<int64_t>(0, budget))
+        .arg(int(plan.vecIds.size()))
+        .arg(int(plan.value))
+        .arg(plan.optimal ? "" : " (best found)"));
+
+    // Most valuable first
+    std::vector<const FBBPlayer*> vecPlanned;
+    for (uint32_t id : plan.vecIds) {
+        vecPlanned.push_back(pModel->GetPlayer(id));
+    }
+    std::sort(vecPlanned.begin(), vecPlanned.end(), [](const FBBPlayer* pLhs, const FBBPlayer* pRhs) {
+        return pLhs->Estimate() > pRhs->Estimate();
+    });
+
+    m_pTable->setRowCount(int(vecPlanned.size()));
+    for (int row = 0; row < int(vecPlanned.size()); row++) {
+        const FBBPlayer* pPlayer = vecPlanned[row];
+        const float price = pPlayer->MarketPrice() > 0.f ? pPlayer->MarketPrice() : pPlayer->Estimate();
+        m_pTable->setItem(row, 0, new QTableWidgetItem(pPlayer->Name()));
+        m_pTable->setItem(row, 1, new QTableWidgetItem(FBBPositionMaskToString(pPlayer->EligablePositions(), false)));
+        m_pTable->setItem(row, 2, new QTableWidgetItem(QString("$%1").arg(int(std::ceil(std::max(1.f, price))))));
+        m_pTable->setItem(row, 3, new QTableWidgetItem(QString("$%1").arg(int(pPlayer->Estimate()))));
+    }
+}
@@ -0,0 +1,309 @@
+#include "FBB/FBBRosterPlanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+std::vector<FBBRosterSlots::Slot> FBBTeamSlots(const FBBLeaugeSettings& settings, FBBPlayer::PlayerType type)
+{
+    const FBBLeaugeSettings::Positions::Hitting& hitting = settings.positions.hitting;
+    const FBBLeaugeSettings::Positions::Pitching& pitching = settings.positions.pitching;
+    if (type == FBBPlayer::PLAYER_TYPE_HITTER) {
+        return {
+            { FBB_POSITION_C, hitting.numC },
+            { FBB_POSITION_1B, hitting.num1B },
+            { FBB_POSITION_2B, hitting.num2B },
+            { FBB_POSITION_SS, hitting.numSS },
+            { FBB_POSITION_3B, hitting.num3B },
+            { FBB_POSITION_MI, hitting.numMI },
+            { FBB_POSITION_CI, hitting.numCI },
+            { FBB_POSITION_IF, hitting.numIF },
+            { FBB_POSITION_LF, hitting.numLF },
+            { FBB_POSITION_CF, hitting.numCF },
+            { FBB_POSITION_RF, hitting.numRF },
+            { FBB_POSITION_OF, hitting.numOF },
+            { FBB_POSITION_DH, hitting.numDH },
+            { FBB_POSITION_U, hitting.numU },
+        };
+    }
+    return {
+        { FBB_POSITION_SP, pitching.numSP },
+        { FBB_POSITION_RP, pitching.numRP },
+        { FBB_POSITION_P, pitching.numP },
+    };
+}
+
+namespace {
+
+using Candidate = FBBRosterPlanner::Candidate;
+using Clock = std::chrono::steady_clock;
+
+// Plans within this much of the incumbent aren't worth exploring
+const float EPSILON = 1e-3f;
+
+struct Search
+{
+    // Candidates by descending value and what each costs beyond $1
+    std::vector<Candidate> vecCandidates;
+    std::vector<int64_t> vecExtra;
+
+    // Bitsets (words per candidate) of the candidates each one dominates,
+    // and of the ones ruled out on the current path
+    size_t words = 0;
+    std::vector<uint64_t> vecDominated;
+    std::vector<uint64_t> vecForbidden;
+    std::vector<uint64_t> vecUndo;
+
+    // Prices per dollar tried in the bound
+    std::vector<float> vecLambda;
+    std::vector<float> vecScratch;
+
+    std::vector<uint32_t> vecChosen;
+    std::vector<uint32_t> vecBest;
+    float best = 0.f;
+
+    uint64_t nodes = 0;
+    Clock::time_point deadline;
+    bool aborted = false;
+
+    bool IsForbidden(size_t i) const
+    {
+        return (vecForbidden[i / 64] >> (i % 64)) & 1;
+    }
+
+    float Bound(size_t begin, uint32_t open, int64_t capacity)
+    {
+        const size_t count = vecCandidates.size();
+        float ret = 0.f;
+        for (size_t l = 0; l < vecLambda.size(); l++) {
+            const float lambda = vecLambda[l];
+            float bound = lambda * float(capacity);
+            if (lambda == 0.f) {
+                // Candidates are already in value order
+                uint32_t taken = 0;
+                for (size_t i = begin; i < count && taken < open; i++) {
+                    if (!IsForbidden(i)) {
+                        bound += vecCandidates[i].value;
+                        taken++;
+                    }
+                }
+            } else {
+                vecScratch.clear();
+                for (size_t i = begin; i < count; i++) {
+                    const float reduced = vecCandidates[i].value - lambda * float(vecExtra[i]);
+                    if (reduced > 0.f && !IsForbidden(i)) {
+                        vecScratch.push_back(reduced);
+                    }
+                }
+                if (vecScratch.size() > open) {
+                    std::nth_element(vecScratch.begin(), vecScratch.begin() + open, vecScratch.end(), std::greater<float>());
+                    vecScratch.resize(open);
+                }
+                for (float reduced : vecScratch) {
+                    bound += reduced;
+                }
+            }
+            ret = l == 0 ? bound : std::min(ret, bound);
+        }
+        return ret;
+    }
+
+    void Visit(size_t i, const FBBRosterSlots& roster, uint32_t open, int64_t capacity, float value)
+    {
+        if (aborted) {
+            return;
+        }
+        if ((++nodes & 255) == 0 && Clock::now() > deadline) {
+            aborted = true;
+            return;
+        }
+
+        if (value > best) {
+            best = value;
+            vecBest = vecChosen;
+        }
+        if (open == 0) {
+            return;
+        }
+
+        const size_t count = vecCandidates.size();
+        while (i < count && IsForbidden(i)) {
+            i++;
+        }
+        if (i == count || value + Bound(i, open, capacity) <= best + EPSILON) {
+            return;
+        }
+
+        // Take the candidate
+        const Candidate& candidate = vecCandidates[i];
+        if (vecExtra[i] <= capacity) {
+            FBBRosterSlots next = roster;
+            if (next.Place(static_cast<uint32_t>(i), candidate.eligible)) {
+                vecChosen.push_back(static_cast<uint32_t>(i));
+                Visit(i + 1, next, open - 1, capacity - vecExtra[i], value + candidate.value);
+                vecChosen.pop_back();
+            }
+        }
+
+        // Leave them, and with them everyone they dominate. Indices only grow
+        // along a path so each one owns its undo words.
+        uint64_t* pUndo = vecUndo.data() + i * words;
+        const uint64_t* pDominated = vecDominated.data() + i * words;
+        for (size_t w = 0; w < words; w++) {
+            pUndo[w] = pDominated[w] & ~vecForbidden[w];
+            vecForbidden[w] |= pUndo[w];
+        }
+        Visit(i + 1, roster, open, capacity, value);
+        for (size_t w = 0; w < words; w++) {
+            vecForbidden[w] &= ~pUndo[w];
+        }
+    }
+
+    // Greedy plan taking candidates in the given order wherever they fit
+    float Greedy(const std::vector<uint32_t>& vecOrder, const FBBRosterSlots& root, int64_t capacity, std::vector<uint32_t>& vecTaken) const
+    {
+        FBBRosterSlots roster = root;
+        std::vector<uint8_t> vecUsed(vecCandidates.size(), 0);
+        float value = 0.f;
+        vecTaken.clear();
+        for (uint32_t i : vecOrder) {
+            if (roster.IsFull()) {
+                break;
+            }
+            if (vecUsed[i] || vecExtra[i] > capacity || !roster.Place(i, vecCandidates[i].eligible)) {
+                continue;
+            }
+            vecUsed[i] = 1;
+            vecTaken.push_back(i);
+            capacity -= vecExtra[i];
+            value += vecCandidates[i].value;
+        }
+        return value;
+    }
+};
+
+}
+
+const FBBRosterPlanner::Plan& FBBRosterPlanner::Solve(const FBBRosterSlots& root, uint32_t budget, const std::vector<Candidate>& vecCandidates, double budgetMs)
+{
+    const Clock::time_point start = Clock::now();
+    const std::vector<uint32_t> vecPrevious = m_plan.vecIds;
+    m_plan = Plan();
+
+    const uint32_t open = root.OpenSlots();
+
+    // Money beyond the $1 held back for every open slot
+    const int64_t capacity = std::max<int64_t>(0, int64_t(budget) - int64_t(open));
+
+    Search search;
+    for (const Candidate& candidate : vecCandidates) {
+        if (candidate.value > 0.f && (candidate.eligible & root.Positions()) && int64_t(candidate.cost) - 1 <= capacity) {
+            search.vecCandidates.push_back(candidate);
+        }
+    }
+    std::sort(search.vecCandidates.begin(), search.vecCandidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.value != rhs.value ? lhs.value > rhs.value : lhs.id < rhs.id;
+    });
+
+    // Drop candidates with at least a slot's worth of dominators
+    {
+        const std::vector<Candidate>& vecSorted = search.vecCandidates;
+        std::vector<Candidate> vecKept;
+        for (size_t j = 0; j < vecSorted.size(); j++) {
+            uint32_t dominators = 0;
+            for (size_t i = 0; i < j && dominators < open; i++) {
+                if ((vecSorted[i].eligible & vecSorted[j].eligible) == vecSorted[j].eligible && vecSorted[i].cost <= vecSorted[j].cost) {
+                    dominators++;
+                }
+            }
+            if (dominators < open) {
+                vecKept.push_back(vecSorted[j]);
+            }
+        }
+        search.vecCandidates.swap(vecKept);
+    }
+
+    const size_t count = search.vecCandidates.size();
+    search.vecExtra.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        search.vecExtra[i] = int64_t(search.vecCandidates[i].cost) - 1;
+    }
+
+    search.words = (count + 63) / 64;
+    search.vecDominated.assign(count * search.words, 0);
+    search.vecForbidden.assign(search.words, 0);
+    search.vecUndo.assign(count * search.words, 0);
+    for (size_t i = 0; i < count; i++) {
+        const Candidate& dominator = search.vecCandidates[i];
+        for (size_t j = i + 1; j < count; j++) {
+            const Candidate& candidate = search.vecCandidates[j];
+            if ((dominator.eligible & candidate.eligible) == candidate.eligible && dominator.cost <= candidate.cost) {
+                search.vecDominated[i * search.words + j / 64] |= uint64_t(1) << (j % 64);
+            }
+        }
+    }
+
+    // Prices per dollar around the candidates' value per dollar
+    search.vecLambda.push_back(0.f);
+    {
+        std::vector<float> vecDensity;
+        for (size_t i = 0; i < count; i++) {
+            if (search.vecExtra[i] > 0) {
+                vecDensity.push_back(search.vecCandidates[i].value / float(search.vecExtra[i]));
+            }
+        }
+        std::sort(vecDensity.begin(), vecDensity.end());
+        for (size_t quartile = 1; quartile <= 3 && !vecDensity.empty(); quartile++) {
+            search.vecLambda.push_back(vecDensity[vecDensity.size() * quartile / 4]);
+        }
+    }
+
+    // Incumbent: the last plan (minus anyone gone) topped up by value, or
+    // the best greedy plan by value less each price per dollar
+    std::vector<uint32_t> vecByValue(count);
+    for (uint32_t i = 0; i < count; i++) {
+        vecByValue[i] = i;
+    }
+    std::vector<uint32_t> vecWarm;
+    {
+        std::unordered_map<uint32_t, uint32_t> mapIndex;
+        for (uint32_t i = 0; i < count; i++) {
+            mapIndex[search.vecCandidates[i].id] = i;
+        }
+        for (uint32_t id : vecPrevious) {
+            auto itr = mapIndex.find(id);
+            if (itr != mapIndex.end()) {
+                vecWarm.push_back(itr->second);
+            }
+        }
+        std::sort(vecWarm.begin(), vecWarm.end());
+        vecWarm.insert(vecWarm.end(), vecByValue.begin(), vecByValue.end());
+    }
+    std::vector<uint32_t> vecTaken;
+    search.best = search.Greedy(vecWarm, root, capacity, search.vecBest);
+    for (float lambda : search.vecLambda) {
+        std::vector<uint32_t> vecOrder = vecByValue;
+        std::stable_sort(vecOrder.begin(), vecOrder.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return search.vecCandidates[lhs].value - lambda * search.vecExtra[lhs] > search.vecCandidates[rhs].value - lambda * search.vecExtra[rhs];
+        });
+        const float greedy = search.Greedy(vecOrder, root, capacity, vecTaken);
+        if (greedy > search.best) {
+            search.best = greedy;
+            search.vecBest = vecTaken;
+        }
+    }
+
+    // Branch and bound for whatever time is left
+    const auto budgetTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMs));
+    search.deadline = start + budgetTime;
+    search.Visit(0, root, open, capacity, 0.f);
+
+    for (uint32_t i : search.vecBest) {
+        const Candidate& candidate = search.vecCandidates[i];
+        m_plan.vecIds.push_back(candidate.id);
+        m_plan.cost += candidate.cost;
+        m_plan.value += candidate.value;
+    }
+    m_plan.optimal = !search.aborted;
+    return m_plan;
+}
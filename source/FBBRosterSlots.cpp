@@ -0,0 +1,95 @@
+#include "FBB/FBBRosterSlots.h"
+
+#include <algorithm>
+
+FBBRosterSlots::FBBRosterSlots(const std::vector<Slot>& vecSlots)
+{
+    for (const Slot& slot : vecSlots) {
+        if (slot.second == 0) {
+            continue;
+        }
+        m_vecPositions.push_back({ slot.first, slot.second, {} });
+        m_vecPositions.back().vecPlaced.reserve(slot.second);
+        m_positions |= slot.first;
+        m_open += slot.second;
+    }
+
+    m_vecParent.resize(m_vecPositions.size());
+    m_vecVisited.resize(m_vecPositions.size());
+    m_vecQueue.reserve(m_vecPositions.size());
+}
+
+bool FBBRosterSlots::Place(uint32_t id, FBBPositionMask eligible)
+{
+    if (m_open == 0 || !(eligible & m_positions)) {
+        return false;
+    }
+
+    const int32_t count = static_cast<int32_t>(m_vecPositions.size());
+
+    // Open slot straight away
+    for (int32_t i = 0; i < count; i++) {
+        Position& position = m_vecPositions[i];
+        if ((eligible & position.position) && position.vecPlaced.size() < position.count) {
+            position.vecPlaced.push_back({ id, eligible });
+            m_open--;
+            return true;
+        }
+    }
+
+    // Breadth-first search for a chain of moves that ends in an open slot
+    std::fill(m_vecVisited.begin(), m_vecVisited.end(), uint8_t(0));
+    m_vecQueue.clear();
+    for (int32_t i = 0; i < count; i++) {
+        if (eligible & m_vecPositions[i].position) {
+            m_vecVisited[i] = 1;
+            m_vecParent[i] = { -1, -1 };
+            m_vecQueue.push_back(i);
+        }
+    }
+
+    int32_t found = -1;
+    for (size_t head = 0; head < m_vecQueue.size() && found < 0; head++) {
+        const int32_t from = m_vecQueue[head];
+        const std::vector<Entry>& vecPlaced = m_vecPositions[from].vecPlaced;
+        for (int32_t index = 0; index < int32_t(vecPlaced.size()) && found < 0; index++) {
+            for (int32_t to = 0; to < count; to++) {
+                if (m_vecVisited[to] || !(vecPlaced[index].eligible & m_vecPositions[to].position)) {
+                    continue;
+                }
+                m_vecVisited[to] = 1;
+                m_vecParent[to] = { from, index };
+                if (m_vecPositions[to].vecPlaced.size() < m_vecPositions[to].count) {
+                    found = to;
+                    break;
+                }
+                m_vecQueue.push_back(to);
+            }
+        }
+    }
+    if (found < 0) {
+        return false;
+    }
+
+    // Shift players along the chain; the new player takes the first position
+    int32_t current = found;
+    int32_t hole = -1;
+    for (;;) {
+        const Parent parent = m_vecParent[current];
+        const Entry incoming = parent.position < 0 ? Entry{ id, eligible } : m_vecPositions[parent.position].vecPlaced[parent.index];
+        std::vector<Entry>& vecPlaced = m_vecPositions[current].vecPlaced;
+        if (hole < 0) {
+            vecPlaced.push_back(incoming);
+        } else {
+            vecPlaced[hole] = incoming;
+        }
+        if (parent.position < 0) {
+            break;
+        }
+        current = parent.position;
+        hole = parent.index;
+    }
+
+    m_open--;
+    return true;
+}
@@ -0,0 +1,119 @@
+#include "FBB/FBBSGP.h"
+#include "FBB/FBBCSVReader.h"
+
+#include <QMap>
+
+#include <algorithm>
+#include <cmath>
+
+static QMap<QString, float>& Denominators(FBBPlayer::PlayerType type, FBBLeaugeSettings::SGP& sgp)
+{
+    return type == FBBPlayer::PLAYER_TYPE_HITTER ? sgp.hitting : sgp.pitching;
+}
+
+std::vector<float> FBBSGPDenominators(FBBPlayer::PlayerType type, const std::vector<const FBBCategory*>& vecCategories, const FBBLeaugeSettings::SGP& sgp)
+{
+    const QMap<QString, float>& denominators = type == FBBPlayer::PLAYER_TYPE_HITTER ? sgp.hitting : sgp.pitching;
+    std::vector<float> ret;
+    ret.reserve(vecCategories.size());
+    for (const FBBCategory* pCategory : vecCategories) {
+        ret.push_back(denominators.value(pCategory->name, pCategory->sgp));
+    }
+    return ret;
+}
+
+// Least squares slope of the values against places 1..n
+static double StandingsSlope(std::vector<double>& vecValues)
+{
+    std::sort(vecValues.begin(), vecValues.end());
+    const double n = double(vecValues.size());
+    const double meanPlace = (n + 1) / 2;
+    double meanValue = 0;
+    for (double value : vecValues) {
+        meanValue += value / n;
+    }
+
+    double covariance = 0;
+    double variance = 0;
+    for (size_t i = 0; i < vecValues.size(); i++) {
+        const double place = double(i + 1) - meanPlace;
+        covariance += place * (vecValues[i] - meanValue);
+        variance += place * place;
+    }
+    return variance > 0 ? covariance / variance : 0;
+}
+
+size_t FBBFitSGPDenominators(const QByteArray& csv, FBBLeaugeSettings::SGP& sgp)
+{
+    FBBCSVReader reader(csv);
+    if (!reader.ReadRow()) {
+        return 0;
+    }
+
+    // Map the header onto categories
+    struct Column
+    {
+        size_t field;
+        const FBBCategory* pCategory;
+    };
+    std::vector<Column> vecColumns;
+    size_t seasonField = SIZE_MAX;
+    for (size_t field = 0; field < reader.FieldCount(); field++) {
+        const QString name = reader[field].ToString().trimmed();
+        if (name.compare("Season", Qt::CaseInsensitive) == 0) {
+            seasonField = field;
+            continue;
+        }
+
+        const bool isPitching = name.startsWith("P:", Qt::CaseInsensitive);
+        const QString categoryName = isPitching ? name.mid(2).trimmed() : name;
+        const FBBCategory* pFound = nullptr;
+        for (FBBPlayer::PlayerType type : { FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::PLAYER_TYPE_PITCHER }) {
+            if (pFound || (isPitching && type == FBBPlayer::PLAYER_TYPE_HITTER)) {
+                continue;
+            }
+            for (const FBBCategory& category : FBBCategories(type)) {
+                if (categoryName.compare(category.name, Qt::CaseInsensitive) == 0) {
+                    pFound = &category;
+                    break;
+                }
+            }
+        }
+        if (pFound) {
+            vecColumns.push_back({ field, pFound });
+        }
+    }
+    if (vecColumns.empty()) {
+        return 0;
+    }
+
+    // Team values by season, then by column
+    QMap<QString, std::vector<std::vector<double>>> seasons;
+    while (reader.ReadRow()) {
+        const QString season = seasonField != SIZE_MAX ? reader[seasonField].ToString() : QString();
+        std::vector<std::vector<double>>& vecValues = seasons[season];
+        vecValues.resize(vecColumns.size());
+        for (size_t i = 0; i < vecColumns.size(); i++) {
+            vecValues[i].push_back(reader[vecColumns[i].field].ToFloat());
+        }
+    }
+
+    // Average the slope over the seasons with enough teams to fit
+    size_t fitted = 0;
+    for (size_t i = 0; i < vecColumns.size(); i++) {
+        double sum = 0;
+        size_t count = 0;
+        for (std::vector<std::vector<double>>& vecValues : seasons) {
+            if (vecValues[i].size() >= 2) {
+                sum += std::fabs(StandingsSlope(vecValues[i]));
+                count++;
+            }
+        }
+        if (count > 0 && sum > 0) {
+            const FBBCategory* pCategory = vecColumns[i].pCategory;
+            Denominators(pCategory->type, sgp)[pCategory->name] = float(sum / count);
+            fitted++;
+        }
+    }
+    return fitted;
+}
@@ -0,0 +1,288 @@
+#include "FBB/FBBSeasonSimulator.h"
+#include "FBB/FBBCategory.h"
+#include "FBB/FBBPlayerStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+// Trials claimed by a worker at a time
+static const uint32_t BATCH_SIZE = 256;
+
+// Spread of a player's playing time and of their per-category performance
+// (rate categories only vary with performance)
+static const float PLAYING_TIME_NOISE = 0.15f;
+static const float MIN_PLAYING_TIME = 0.1f;
+static const float MAX_PLAYING_TIME = 1.25f;
+static const float COUNTING_NOISE = 0.12f;
+static const float RATE_NOISE = 0.05f;
+
+// Standard normal quantiles at the middle of 4096 equal probability bins
+static const uint32_t NORMAL_TABLE_BITS = 12;
+static const uint64_t NORMAL_TABLE_MASK = (1ull << NORMAL_TABLE_BITS) - 1;
+
+static const std::vector<float>& NormalTable()
+{
+    static const std::vector<float> s_table = []() {
+        std::vector<float> table(size_t(1) << NORMAL_TABLE_BITS);
+        for (size_t i = 0; i < table.size(); i++) {
+            const double p = (i + 0.5) / table.size();
+            double lo = -8;
+            double hi = 8;
+            for (uint32_t step = 0; step < 64; step++) {
+                const double mid = (lo + hi) / 2;
+                (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p ? lo : hi) = mid;
+            }
+            table[i] = float((lo + hi) / 2);
+        }
+        return table;
+    }();
+    return s_table;
+}
+
+static void FillDeviates(std::mt19937_64& rng, std::vector<float>& vecDeviates, size_t count)
+{
+    const std::vector<float>& table = NormalTable();
+    vecDeviates.resize(count);
+    size_t i = 0;
+    while (i < count) {
+        uint64_t bits = rng();
+        for (uint32_t j = 0; j < 64 / NORMAL_TABLE_BITS && i < count; j++) {
+            vecDeviates[i++] = table[bits & NORMAL_TABLE_MASK];
+            bits >>= NORMAL_TABLE_BITS;
+        }
+    }
+}
+
+FBBSeasonSimulator::State FBBSeasonSimulator::FromDraft(const FBBPlayerStore& store, const FBBLeaugeSettings& settings)
+{
+    State state;
+    std::map<FBBOwnerId, uint32_t> mapOwners;
+    for (const auto& owner : settings.owners) {
+        mapOwners[owner.first] = static_cast<uint32_t>(state.vecOwners.size());
+        state.vecOwners.push_back(owner.first);
+    }
+    const size_t numOwners = state.vecOwners.size();
+
+    for (FBBPlayer::PlayerType type : { FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::PLAYER_TYPE_PITCHER }) {
+        const FBBPlayerColumns& columns = store.Columns(type);
+
+        // Rosters of this type, numbered after the players before them
+        std::vector<std::vector<uint32_t>> vecRosters(numOwners);
+        for (uint32_t row = 0; row < columns.Count(); row++) {
+            auto itr = mapOwners.find(columns.owner[row]);
+            if (itr != mapOwners.end()) {
+                vecRosters[itr->second].push_back(row);
+            }
+        }
+        const uint32_t firstPlayer = state.numPlayers;
+        for (const std::vector<uint32_t>& vecRoster : vecRosters) {
+            state.numPlayers += static_cast<uint32_t>(vecRoster.size());
+        }
+
+        for (const FBBCategory* pCategory : FBBEnabledCategories(type, settings.categories)) {
+            Category category;
+            category.name = pCategory->name;
+            category.isRate = pCategory->IsRate();
+            category.sign = pCategory->sign;
+            category.vecOwnerBegin.push_back(0);
+
+            uint32_t player = firstPlayer;
+            for (const std::vector<uint32_t>& vecRoster : vecRosters) {
+                for (uint32_t row : vecRoster) {
+                    category.vecPlayer.push_back(player++);
+                    category.vecNum.push_back(pCategory->numerator(columns, row));
+                    if (category.isRate) {
+                        category.vecDen.push_back(pCategory->denominator(columns, row));
+                    }
+                }
+                category.vecOwnerBegin.push_back(static_cast<uint32_t>(category.vecPlayer.size()));
+            }
+            state.vecCategories.push_back(std::move(category));
+        }
+    }
+
+    return state;
+}
+
+void FBBSeasonSimulator::Tally::Reset(size_t numOwners, size_t numCategories)
+{
+    vecFinish.assign(numOwners * numOwners, 0);
+    vecPoints.assign(numOwners * numCategories, 0.0);
+    trials = 0;
+}
+
+void FBBSeasonSimulator::Tally::Merge(const Tally& tally)
+{
+    for (size_t i = 0; i < vecFinish.size(); i++) {
+        vecFinish[i] += tally.vecFinish[i];
+    }
+    for (size_t i = 0; i < vecPoints.size(); i++) {
+        vecPoints[i] += tally.vecPoints[i];
+    }
+    trials += tally.trials;
+}
+
+class FBBSeasonSimulator::Worker : public FBBSimulationRunner::Worker
+{
+public:
+
+    Worker(FBBSeasonSimulator* pSimulator)
+        : m_pSimulator(pSimulator)
+    {
+        m_tally.Reset(m_pSimulator->m_state.vecOwners.size(), m_pSimulator->m_state.vecCategories.size());
+    }
+
+    virtual void Run(std::mt19937_64& rng) override
+    {
+        m_pSimulator->Trial(rng, m_tally, m_scratch);
+        m_tally.trials++;
+    }
+
+    virtual void Publish() override
+    {
+        m_pSimulator->m_tally.Merge(m_tally);
+        m_tally.Reset(m_pSimulator->m_state.vecOwners.size(), m_pSimulator->m_state.vecCategories.size());
+    }
+
+private:
+
+    FBBSeasonSimulator* m_pSimulator;
+    Tally m_tally;
+    Scratch m_scratch;
+};
+
+FBBSeasonSimulator::FBBSeasonSimulator(QObject* parent)
+    : QObject(parent)
+    , m_runner(BATCH_SIZE)
+{
+}
+
+FBBSeasonSimulator::~FBBSeasonSimulator()
+{
+    m_runner.Stop();
+}
+
+void FBBSeasonSimulator::Start(const State& state, uint32_t numTrials, uint64_t seed)
+{
+    m_runner.Stop();
+
+    m_state = state;
+    m_tally.Reset(m_state.vecOwners.size(), m_state.vecCategories.size());
+
+    // Build the table before the workers race for it
+    NormalTable();
+
+    const bool isEmpty = m_state.vecOwners.empty() || m_state.vecCategories.empty();
+    m_runner.Start(isEmpty ? 0 : numTrials, seed, [this]() {
+        return std::unique_ptr<FBBSimulationRunner::Worker>(new Worker(this));
+    }, [this](uint32_t completed, uint32_t total) {
+        emit Progress(completed, total);
+    });
+}
+
+void FBBSeasonSimulator::Cancel()
+{
+    m_runner.Cancel();
+}
+
+FBBSeasonSimulator::Results FBBSeasonSimulator::Current() const
+{
+    std::lock_guard<std::mutex> lock(m_runner.Mutex());
+
+    Results ret;
+    ret.trials = m_tally.trials;
+    if (ret.trials == 0) {
+        return ret;
+    }
+
+    const size_t numOwners = m_state.vecOwners.size();
+    const size_t numCategories = m_state.vecCategories.size();
+    ret.vecFinish.resize(m_tally.vecFinish.size());
+    for (size_t i = 0; i < ret.vecFinish.size(); i++) {
+        ret.vecFinish[i] = m_tally.vecFinish[i] / float(ret.trials);
+    }
+    ret.vecPoints.resize(m_tally.vecPoints.size());
+    ret.vecTotal.assign(numOwners, 0.f);
+    for (size_t owner = 0; owner < numOwners; owner++) {
+        for (size_t k = 0; k < numCategories; k++) {
+            const float points = float(m_tally.vecPoints[owner * numCategories + k] / ret.trials);
+            ret.vecPoints[owner * numCategories + k] = points;
+            ret.vecTotal[owner] += points;
+        }
+    }
+    return ret;
+}
+
+void FBBSeasonSimulator::Trial(std::mt19937_64& rng, Tally& tally, Scratch& scratch) const
+{
+    const size_t numOwners = m_state.vecOwners.size();
+    const size_t numCategories = m_state.vecCategories.size();
+
+    // One playing time factor per player
+    std::vector<float>& vecPlayingTime = scratch.vecPlayingTime;
+    FillDeviates(rng, vecPlayingTime, m_state.numPlayers);
+    for (float& playingTime : vecPlayingTime) {
+        playingTime = std::min(MAX_PLAYING_TIME, std::max(MIN_PLAYING_TIME, 1.f + PLAYING_TIME_NOISE * playingTime));
+    }
+
+    scratch.vecTotals.assign(numOwners, 0.f);
+    scratch.vecValues.resize(numOwners);
+    for (size_t k = 0; k < numCategories; k++) {
+        const Category& category = m_state.vecCategories[k];
+        const float noise = category.isRate ? RATE_NOISE : COUNTING_NOISE;
+        FillDeviates(rng, scratch.vecDeviates, category.vecNum.size());
+        const float* pDeviates = scratch.vecDeviates.data();
+        const float* pNum = category.vecNum.data();
+        const float* pDen = category.vecDen.data();
+        const uint32_t* pPlayer = category.vecPlayer.data();
+
+        // Owner totals over their contiguous run of players
+        for (size_t owner = 0; owner < numOwners; owner++) {
+            const uint32_t begin = category.vecOwnerBegin[owner];
+            const uint32_t end = category.vecOwnerBegin[owner + 1];
+            float num = 0.f;
+            float den = 0.f;
+            if (category.isRate) {
+                for (uint32_t i = begin; i < end; i++) {
+                    const float playingTime = vecPlayingTime[pPlayer[i]];
+                    num += pNum[i] * playingTime * (1.f + noise * pDeviates[i]);
+                    den += pDen[i] * playingTime;
+                }
+            } else {
+                for (uint32_t i = begin; i < end; i++) {
+                    num += pNum[i] * vecPlayingTime[pPlayer[i]] * (1.f + noise * pDeviates[i]);
+                }
+            }
+            const float value = category.isRate ? (den > 0 ? num / den : 0.f) : num;
+            scratch.vecValues[owner] = category.sign * value;
+        }
+
+        // Roto points: one per owner beaten, ties split
+        const std::vector<float>& vecValues = scratch.vecValues;
+        for (size_t owner = 0; owner < numOwners; owner++) {
+            float points = 1.f;
+            for (size_t other = 0; other < numOwners; other++) {
+                if (vecValues[other] < vecValues[owner]) {
+                    points += 1.f;
+                } else if (other != owner && vecValues[other] == vecValues[owner]) {
+                    points += 0.5f;
+                }
+            }
+            tally.vecPoints[owner * numCategories + k] += points;
+            scratch.vecTotals[owner] += points;
+        }
+    }
+
+    // Finishing places (ties go to the owner listed first)
+    const std::vector<float>& vecTotals = scratch.vecTotals;
+    for (size_t owner = 0; owner < numOwners; owner++) {
+        size_t place = 0;
+        for (size_t other = 0; other < numOwners; other++) {
+            if (vecTotals[other] > vecTotals[owner] || (vecTotals[other] == vecTotals[owner] && other < owner)) {
+                place++;
+            }
+        }
+        tally.vecFinish[owner * numOwners + place]++;
+    }
+}
@@ -0,0 +1,113 @@
+#include "FBB/FBBSimulationRunner.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <chrono>
+
+// Minimum time between progress updates
+static const int64_t PROGRESS_INTERVAL_MS = 100;
+
+// Decorrelates neighbouring simulation indices before seeding
+static uint64_t SplitMix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static int64_t NowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FBBSimulationRunner::FBBSimulationRunner(uint32_t batchSize)
+    : m_batchSize(batchSize)
+    , m_cancel(false)
+    , m_next(0)
+    , m_completed(0)
+{
+}
+
+FBBSimulationRunner::~FBBSimulationRunner()
+{
+    Stop();
+}
+
+void FBBSimulationRunner::Stop()
+{
+    // Workers check the flag between simulations so this is quick
+    Cancel();
+    m_pool.waitForDone();
+}
+
+void FBBSimulationRunner::Start(uint32_t total, uint64_t seed, WorkerFactory factory, ProgressCallback progress)
+{
+    Stop();
+
+    m_total = total;
+    m_seed = seed;
+    m_factory = std::move(factory);
+    m_progress = std::move(progress);
+    m_lastProgress = 0;
+
+    m_next = 0;
+    m_completed = 0;
+    m_cancel = false;
+
+    if (m_total == 0) {
+        m_progress(0, 0);
+        return;
+    }
+
+    const uint32_t numBatches = (m_total + m_batchSize - 1) / m_batchSize;
+    const uint32_t numWorkers = std::min<uint32_t>(std::max(1, m_pool.maxThreadCount()), numBatches);
+    for (uint32_t i = 0; i < numWorkers; i++) {
+        QtConcurrent::run(&m_pool, [this]() { Work(); });
+    }
+}
+
+void FBBSimulationRunner::Cancel()
+{
+    m_cancel = true;
+}
+
+void FBBSimulationRunner::Work()
+{
+    std::mt19937_64 rng;
+    const std::unique_ptr<Worker> spWorker = m_factory();
+
+    while (!m_cancel) {
+        const uint32_t begin = m_next.fetch_add(m_batchSize);
+        if (begin >= m_total) {
+            break;
+        }
+        const uint32_t end = std::min(begin + m_batchSize, m_total);
+        for (uint32_t i = begin; i < end; i++) {
+            if (m_cancel) {
+                return;
+            }
+            rng.seed(SplitMix64(m_seed + i));
+            spWorker->Run(rng);
+        }
+
+        // Publish the batch
+        bool notify = false;
+        uint32_t completed = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            spWorker->Publish();
+            completed = m_completed += end - begin;
+            const int64_t now = NowMs();
+            if (completed == m_total || now - m_lastProgress >= PROGRESS_INTERVAL_MS) {
+                m_lastProgress = now;
+                notify = true;
+            }
+        }
+
+        if (notify && !m_cancel) {
+            m_progress(completed, m_total);
+        }
+    }
+}
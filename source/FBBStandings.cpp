@@ -0,0 +1,144 @@
+#include "FBB/FBBStandings.h"
+#include "FBB/FBBApplication.h"
+#include "FBB/FBBDraftBoardModel.h"
+#include "FBB/FBBProjectionService.h"
+#include "FBB/FBBSeasonSimulator.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QLabel>
+#include <QTableWidget>
+#include <QHeaderView>
+
+// Trials per run and a fixed seed so the same rosters give the same odds
+static const uint32_t NUM_TRIALS = 100000;
+static const uint64_t SEED = 0x46424253454153ull;
+
+FBBStandings::FBBStandings(QWidget* pParent)
+    : QWidget(pParent)
+    , m_pSimulator(new FBBSeasonSimulator(this))
+{
+    // Main layout
+    QVBoxLayout* pLayout = new QVBoxLayout(this);
+
+    // Controls
+    QHBoxLayout* pControlLayout = new QHBoxLayout();
+    QPushButton* pSimulateButton = new QPushButton("Simulate Season", this);
+    m_pStatus = new QLabel(this);
+    pControlLayout->addWidget(pSimulateButton);
+    pControlLayout->addWidget(m_pStatus);
+    pControlLayout->addStretch();
+    pLayout->addLayout(pControlLayout);
+
+    // Finish distribution and expected category points
+    auto MakeTable = [this]() {
+        QTableWidget* pTable = new QTableWidget(this);
+        pTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        pTable->setSelectionMode(QAbstractItemView::NoSelection);
+        pTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        pTable->verticalHeader()->setDefaultSectionSize(15);
+        pTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+        return pTable;
+    };
+    m_pFinish = MakeTable();
+    m_pCategories = MakeTable();
+    pLayout->addWidget(new QLabel("Finish", this));
+    pLayout->addWidget(m_pFinish);
+    pLayout->addWidget(new QLabel("Expected Category Points", this));
+    pLayout->addWidget(m_pCategories);
+
+    connect(pSimulateButton, &QPushButton::clicked, this, [this]() {
+        Simulate();
+    });
+
+    // Progress comes from the worker threads (queued)
+    connect(m_pSimulator, &FBBSeasonSimulator::Progress, this, [this](uint32_t, uint32_t) {
+        Refresh();
+    });
+
+    // Keep the odds current once they have been asked for
+    connect(fbbApp->DraftBoardModel(), &FBBDraftBoardModel::PlayerDrafted, this, [this](FBBPlayer*) {
+        if (m_simulated) {
+            Simulate();
+        }
+    });
+    connect(fbbApp->DraftBoardModel(), &FBBDraftBoardModel::DraftLoaded, this, [this]() {
+        if (m_simulated) {
+            Simulate();
+        }
+    });
+}
+
+void FBBStandings::Simulate()
+{
+    const FBBPlayerStore* pStore = FBBProjectionService::Instance().Store();
+    if (!pStore) {
+        return;
+    }
+
+    m_simulated = true;
+    m_pSimulator->Start(FBBSeasonSimulator::FromDraft(*pStore, *fbbApp->Settings()), NUM_TRIALS, SEED);
+}
+
+void FBBStandings::Refresh()
+{
+    const FBBSeasonSimulator::State& state = m_pSimulator->Snapshot();
+    const FBBSeasonSimulator::Results results = m_pSimulator->Current();
+    const FBBLeaugeSettings* pSettings = fbbApp->Settings();
+
+    m_pStatus->setText(QString("%1 / %2 seasons").arg(m_pSimulator->Completed()).arg(m_pSimulator->Total()));
+    if (results.trials == 0) {
+        return;
+    }
+
+    const int numOwners = int(state.vecOwners.size());
+    const int numCategories = int(state.vecCategories.size());
+
+    QStringList ownerLabels;
+    for (FBBOwnerId id : state.vecOwners) {
+        auto itr = pSettings->owners.find(id);
+        ownerLabels << (itr != pSettings->owners.end() ? itr->second->name : QString());
+    }
+
+    auto SetCell = [](QTableWidget* pTable, int row, int column, const QString& text) {
+        QTableWidgetItem* pItem = pTable->item(row, column);
+        if (!pItem) {
+            pItem = new QTableWidgetItem();
+            pItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            pTable->setItem(row, column, pItem);
+        }
+        pItem->setText(text);
+    };
+
+    // Expected points then the chance of each place
+    QStringList finishLabels;
+    finishLabels << "Points";
+    for (int place = 1; place <= numOwners; place++) {
+        finishLabels << QString::number(place);
+    }
+    m_pFinish->setRowCount(numOwners);
+    m_pFinish->setColumnCount(numOwners + 1);
+    m_pFinish->setHorizontalHeaderLabels(finishLabels);
+    m_pFinish->setVerticalHeaderLabels(ownerLabels);
+    for (int owner = 0; owner < numOwners; owner++) {
+        SetCell(m_pFinish, owner, 0, QString::number(results.vecTotal[owner], 'f', 1));
+        for (int place = 0; place < numOwners; place++) {
+            SetCell(m_pFinish, owner, place + 1, QString::number(100 * results.vecFinish[owner * numOwners + place], 'f', 1) + "%");
+        }
+    }
+
+    QStringList categoryLabels;
+    for (const FBBSeasonSimulator::Category& category : state.vecCategories) {
+        categoryLabels << category.name;
+    }
+    m_pCategories->setRowCount(numOwners);
+    m_pCategories->setColumnCount(numCategories);
+    m_pCategories->setHorizontalHeaderLabels(categoryLabels);
+    m_pCategories->setVerticalHeaderLabels(ownerLabels);
+    for (int owner = 0; owner < numOwners; owner++) {
+        for (int k = 0; k < numCategories; k++) {
+            SetCell(m_pCategories, owner, k, QString::number(results.vecPoints[owner * numCategories + k], 'f', 1));
+        }
+    }
+}
@@ -0,0 +1,199 @@
+#include "FBB/FBBSyntheticPool.h"
+#include "FBB/FBBPlayerStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+// mt19937_64 output is fixed by the standard but the library distributions
+// aren't, so draws are made from the raw bits
+class Draws
+{
+public:
+
+    Draws(uint64_t seed) : m_rng(seed) {}
+
+    double Uniform()
+    {
+        return (m_rng() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double Normal()
+    {
+        const double u = 1.0 - Uniform();
+        const double v = Uniform();
+        return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+    }
+
+    uint32_t Below(uint32_t count)
+    {
+        return std::min(count - 1, uint32_t(Uniform() * count));
+    }
+
+private:
+    std::mt19937_64 m_rng;
+};
+
+double Clamp(double value, double lo, double hi)
+{
+    return std::min(hi, std::max(lo, value));
+}
+
+uint32_t Count(double value)
+{
+    return value > 0 ? uint32_t(value + 0.5) : 0;
+}
+
+// Teams players are drawn from (a few are left unsigned)
+const double FREE_AGENT_SHARE = 0.05;
+const uint32_t NUM_TEAMS = uint32_t(FBBTeam::NYY);
+
+FBBTeam DrawTeam(Draws& draws)
+{
+    if (draws.Uniform() < FREE_AGENT_SHARE) {
+        return FBBTeam::FA;
+    }
+    return FBBTeam(1 + draws.Below(NUM_TEAMS));
+}
+
+void DrawIdentity(Draws& draws, FBBPlayer* pPlayer)
+{
+    pPlayer->Team() = DrawTeam(draws);
+    pPlayer->Age() = 20 + draws.Below(19);
+    pPlayer->Experience() = pPlayer->Age() > 23 ? draws.Below(pPlayer->Age() - 22) : 0;
+}
+
+// Appearances are innings in the field, like the appearances CSV
+const double INNINGS_PER_GAME = 8.5;
+
+void GenerateHitter(Draws& draws, const FBBSyntheticPool::Options& options, FBBPlayer* pPlayer)
+{
+    DrawIdentity(draws, pPlayer);
+
+    // Regulars are better players, so talent leans on playing time
+    const double share = std::pow(draws.Uniform(), 0.75);
+    const double lean = 0.8 * (share - 0.5);
+    const double contact = draws.Normal() + lean;
+    const double power = draws.Normal() + lean;
+    const double speed = draws.Normal();
+    const double eye = draws.Normal() + lean;
+
+    const double PA = 20 + 660 * share;
+    const double BB = PA * Clamp(0.085 + 0.025 * eye, 0.03, 0.18);
+    const double HBP = PA * 0.01;
+    const double AB = PA - BB - HBP;
+    const double H = AB * Clamp(0.250 + 0.022 * contact, 0.15, 0.35);
+    const double HR = AB * Clamp(0.033 + 0.014 * power, 0.002, 0.085);
+    const double _3B = AB * Clamp(0.004 + 0.003 * speed, 0.0, 0.015);
+    const double _2B = std::min(AB * Clamp(0.045 + 0.008 * power, 0.02, 0.07), H - HR - _3B);
+    const double SB = PA * Clamp(0.012 + 0.014 * speed, 0.0, 0.07);
+
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_PA) = Count(PA);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_AB) = Count(AB);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_H) = Count(H);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_2B) = Count(_2B);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_3B) = Count(_3B);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_HR) = Count(HR);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_R) = Count(PA * (0.11 + 0.01 * speed) + 0.45 * HR);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_RBI) = Count(PA * (0.10 + 0.01 * contact) + 0.9 * HR);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_BB) = Count(BB);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_SO) = Count(PA * Clamp(0.22 + 0.03 * power - 0.04 * contact, 0.08, 0.38));
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_HBP) = Count(HBP);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_SB) = Count(SB);
+    pPlayer->Hitting(FBBPlayer::HITTING_STAT_CS) = Count(SB * 0.28);
+
+    // Innings at a primary (and maybe a secondary) position
+    const float innings = float(INNINGS_PER_GAME * PA / 4.1);
+    double total = options.dhMix;
+    for (float weight : options.positionMix) {
+        total += weight;
+    }
+    double pick = draws.Uniform() * total;
+    for (size_t position = 0; position < options.positionMix.size(); position++) {
+        pick -= options.positionMix[position];
+        if (pick < 0) {
+            pPlayer->Appearances(FBBPlayer::Fielding(position)) = innings;
+            break;
+        }
+    }
+    if (draws.Uniform() < options.secondaryShare) {
+        const FBBPlayer::Fielding secondary = FBBPlayer::Fielding(draws.Below(FBBPlayer::Fielding_Count));
+        pPlayer->Appearances(secondary) = std::max(pPlayer->Appearances(secondary), 0.3f * innings);
+    }
+}
+
+void GeneratePitcher(Draws& draws, const FBBSyntheticPool::Options& options, FBBPlayer* pPlayer)
+{
+    DrawIdentity(draws, pPlayer);
+
+    const bool isStarter = draws.Uniform() < options.starterShare;
+    const double share = std::pow(draws.Uniform(), 0.75);
+    const double quality = draws.Normal() + 0.8 * (share - 0.5);
+    const double stuff = draws.Normal();
+
+    double G;
+    double GS;
+    double IP;
+    if (isStarter) {
+        GS = 4 + 28 * share;
+        G = GS + draws.Below(4);
+        IP = GS * Clamp(5.2 + 0.8 * share + 0.3 * quality, 4.0, 7.0);
+    } else {
+        GS = 0;
+        G = 15 + 55 * share;
+        IP = G * Clamp(1.0 + 0.1 * quality, 0.8, 1.3);
+    }
+
+    const double WHIP = Clamp(1.32 - 0.11 * quality, 0.85, 1.9);
+    const double BB = IP * WHIP * Clamp(0.27 - 0.02 * stuff, 0.18, 0.38);
+
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_G) = Count(G);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_GS) = Count(GS);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_IP) = Count(IP);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_H) = Count(IP * WHIP - BB);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_BB) = Count(BB);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_ER) = Count(IP * Clamp(4.4 - 0.55 * quality, 1.8, 7.5) / 9);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_HR) = Count(IP * Clamp(1.25 - 0.15 * quality, 0.4, 2.2) / 9);
+    pPlayer->Pitching(FBBPlayer::PITCHING_STAT_SO) = Count(IP * Clamp(8.6 + 1.3 * stuff + 0.4 * quality, 4.0, 14.0) / 9);
+
+    if (isStarter) {
+        pPlayer->Pitching(FBBPlayer::PITCHING_STAT_W) = Count(GS * Clamp(0.33 + 0.05 * quality, 0.15, 0.6));
+        pPlayer->Pitching(FBBPlayer::PITCHING_STAT_L) = Count(GS * Clamp(0.33 - 0.05 * quality, 0.15, 0.6));
+    } else {
+        pPlayer->Pitching(FBBPlayer::PITCHING_STAT_W) = Count(G * 0.05);
+        pPlayer->Pitching(FBBPlayer::PITCHING_STAT_L) = Count(G * 0.04);
+
+        // The best-used relievers close, the next tier sets up
+        if (share > 0.8 && quality > 0.3) {
+            pPlayer->Pitching(FBBPlayer::PITCHING_STAT_SV) = Count(G * 0.55);
+        } else {
+            pPlayer->Pitching(FBBPlayer::PITCHING_STAT_HLD) = Count(G * (share > 0.5 ? 0.25 : 0.08));
+        }
+    }
+}
+
+}
+
+void FBBSyntheticPool::Generate(FBBPlayerStore& store, const Options& options)
+{
+    // Hitters and pitchers draw from separate streams so changing one count
+    // leaves the other's players alone
+    Draws hitterDraws(options.seed);
+    Draws pitcherDraws(options.seed ^ 0x9E3779B97F4A7C15ull);
+
+    store.Reserve(FBBPlayer::PLAYER_TYPE_HITTER, store.Count(FBBPlayer::PLAYER_TYPE_HITTER) + options.numHitters);
+    for (uint32_t i = 0; i < options.numHitters; i++) {
+        const QString id = QString("synh%1").arg(i);
+        const QString name = QString("Hitter %1").arg(i);
+        GenerateHitter(hitterDraws, options, store.Add(FBBPlayer::PLAYER_TYPE_HITTER, id, name));
+    }
+
+    store.Reserve(FBBPlayer::PLAYER_TYPE_PITCHER, store.Count(FBBPlayer::PLAYER_TYPE_PITCHER) + options.numPitchers);
+    for (uint32_t i = 0; i < options.numPitchers; i++) {
+        const QString id = QString("synp%1").arg(i);
+        const QString name = QString("Pitcher %1").arg(i);
+        GeneratePitcher(pitcherDraws, options, store.Add(FBBPlayer::PLAYER_TYPE_PITCHER, id, name));
+    }
+}
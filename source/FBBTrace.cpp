@@ -0,0 +1,213 @@
+#include "FBB/FBBTrace.h"
+
+#include <QCoreApplication>
+#include <QSaveFile>
+#include <QThread>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> FBBTrace::s_enabled(true);
+
+namespace {
+
+// Most recent events kept per thread (a power of two)
+const uint64_t RING_SIZE = 1 << 14;
+
+struct Event
+{
+    std::atomic<const char*> name;
+    std::atomic<int64_t> begin;
+    std::atomic<int64_t> end;
+};
+
+// One thread's events. The owner claims a slot, fills it and publishes it;
+// readers copy the published slots and then discard any the owner has since
+// claimed again (a seqlock over the whole ring).
+struct Ring
+{
+    uint32_t tid = 0;
+    QByteArray threadName;
+    std::atomic<uint64_t> claimed{ 0 };
+    std::atomic<uint64_t> published{ 0 };
+    std::unique_ptr<Event[]> events{ new Event[RING_SIZE] };
+};
+
+// Rings outlive their threads: a finished thread hands its ring (and its
+// events) to the next new thread instead of growing the list, since pool
+// threads come and go. The lock is only taken when a thread starts, ends or
+// the trace is written.
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> vecRings;
+    std::vector<Ring*> vecFree;
+};
+
+Registry& GetRegistry()
+{
+    static Registry* s_pRegistry = new Registry();
+    return *s_pRegistry;
+}
+
+// Timestamps are relative to the first traced event
+int64_t Nanoseconds(FBBTrace::Clock::time_point time)
+{
+    static const FBBTrace::Clock::time_point s_epoch = FBBTrace::Clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - s_epoch).count();
+}
+
+class ThreadRing
+{
+public:
+
+    ThreadRing()
+    {
+        const bool isMain = QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread();
+
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (!registry.vecFree.empty()) {
+            m_pRing = registry.vecFree.back();
+            registry.vecFree.pop_back();
+        } else {
+            registry.vecRings.emplace_back(new Ring());
+            m_pRing = registry.vecRings.back().get();
+            m_pRing->tid = static_cast<uint32_t>(registry.vecRings.size());
+            m_pRing->threadName = isMain ? QByteArray("Main") : QByteArray("Worker ") + QByteArray::number(m_pRing->tid);
+        }
+    }
+
+    ~ThreadRing()
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.vecFree.push_back(m_pRing);
+    }
+
+    Ring* Get() const { return m_pRing; }
+
+private:
+    Ring* m_pRing;
+};
+
+struct Span
+{
+    const char* name;
+    int64_t begin;
+    int64_t end;
+    uint32_t tid;
+};
+
+// Published events of a ring that weren't overwritten while being copied
+void CopyRing(const Ring& ring, std::vector<Span>& vecSpans)
+{
+    const uint64_t published = ring.published.load(std::memory_order_acquire);
+    const uint64_t first = published > RING_SIZE ? published - RING_SIZE : 0;
+
+    const size_t start = vecSpans.size();
+    for (uint64_t i = first; i < published; i++) {
+        const Event& event = ring.events[i & (RING_SIZE - 1)];
+        vecSpans.push_back({
+            event.name.load(std::memory_order_relaxed),
+            event.begin.load(std::memory_order_relaxed),
+            event.end.load(std::memory_order_relaxed),
+            ring.tid });
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = ring.claimed.load(std::memory_order_relaxed);
+    const uint64_t valid = claimed > RING_SIZE ? claimed - RING_SIZE : 0;
+    if (valid > first) {
+        const size_t stale = static_cast<size_t>(std::min(valid, published) - first);
+        vecSpans.erase(vecSpans.begin() + start, vecSpans.begin() + start + stale);
+    }
+}
+
+// Microseconds with nanosecond precision
+void AppendMicroseconds(QByteArray& json, int64_t ns)
+{
+    if (ns < 0) {
+        json += '-';
+        ns = -ns;
+    }
+    json += QByteArray::number(static_cast<qlonglong>(ns / 1000));
+    json += '.';
+    json += QByteArray::number(static_cast<int>(ns % 1000)).rightJustified(3, '0');
+}
+
+}
+
+void FBBTrace::Record(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+    thread_local ThreadRing t_ring;
+    Ring& ring = *t_ring.Get();
+
+    const uint64_t index = ring.published.load(std::memory_order_relaxed);
+    ring.claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Event& event = ring.events[index & (RING_SIZE - 1)];
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(Nanoseconds(begin), std::memory_order_relaxed);
+    event.end.store(Nanoseconds(end), std::memory_order_relaxed);
+    ring.published.store(index + 1, std::memory_order_release);
+}
+
+bool FBBTrace::Write(const QString& file)
+{
+    std::vector<Span> vecSpans;
+    std::vector<std::pair<uint32_t, QByteArray>> vecThreads;
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const std::unique_ptr<Ring>& spRing : registry.vecRings) {
+            CopyRing(*spRing, vecSpans);
+            vecThreads.emplace_back(spRing->tid, spRing->threadName);
+        }
+    }
+
+    // Thread names first, then the spans in time order (enclosing spans
+    // before the ones they contain)
+    std::sort(vecSpans.begin(), vecSpans.end(), [](const Span& lhs, const Span& rhs) {
+        return lhs.begin != rhs.begin ? lhs.begin < rhs.begin : lhs.end > rhs.end;
+    });
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QByteArray json;
+    json.reserve(static_cast<int>(64 + vecSpans.size() * 96));
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool isFirst = true;
+    auto BeginEvent = [&]() {
+        json += isFirst ? "\n{" : ",\n{";
+        isFirst = false;
+    };
+    for (const auto& thread : vecThreads) {
+        BeginEvent();
+        json += "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + QByteArray::number(pid);
+        json += ",\"tid\":" + QByteArray::number(thread.first);
+        json += ",\"args\":{\"name\":\"" + thread.second + "\"}}";
+    }
+    for (const Span& span : vecSpans) {
+        BeginEvent();
+        json += "\"name\":\"";
+        json += span.name;
+        json += "\",\"ph\":\"X\",\"pid\":" + QByteArray::number(pid);
+        json += ",\"tid\":" + QByteArray::number(span.tid);
+        json += ",\"ts\":";
+        AppendMicroseconds(json, span.begin);
+        json += ",\"dur\":";
+        AppendMicroseconds(json, span.end - span.begin);
+        json += '}';
+    }
+    json += "\n]}\n";
+
+    QSaveFile saveFile(file);
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    saveFile.write(json);
+    return saveFile.commit();
+}
@@ -0,0 +1,311 @@
+#include "FBB/FBBValuation.h"
+#include "FBB/FBBPlayer.h"
+
+#include <algorithm>
+
+// Descending zScore, ties broken by row so selection and sorting agree
+struct ZScoreGreater
+{
+    const std::vector<float>& zScore;
+
+    bool operator()(uint32_t lhs, uint32_t rhs) const
+    {
+        return zScore[lhs] != zScore[rhs] ? zScore[lhs] > zScore[rhs] : lhs < rhs;
+    }
+};
+
+void FBBValuation::Prepare(FBBPlayerColumns& columns, const std::vector<uint32_t>& vecRows, double totalMoney)
+{
+    m_pColumns = &columns;
+    m_vecRanked = vecRows;
+    m_ranked = false;
+    m_totalMoney = totalMoney;
+
+    // Picks so far
+    m_numDrafted = 0;
+    m_spent = 0;
+    for (uint32_t row = 0; row < columns.Count(); row++) {
+        if (columns.owner[row] != 0) {
+            m_numDrafted++;
+            m_spent += columns.paid[row];
+        }
+    }
+
+    // Pool membership (ranks are stale until Rank)
+    std::fill(columns.pooled.begin(), columns.pooled.end(), uint8_t(0));
+    std::fill(columns.rank.begin(), columns.rank.end(), 0);
+    std::fill(columns.scarcity.begin(), columns.scarcity.end(), 0.f);
+    m_remaining = 0;
+    for (uint32_t row : vecRows) {
+        columns.pooled[row] = 1;
+        m_remaining += columns.owner[row] == 0 ? 1 : 0;
+    }
+}
+
+void FBBValuation::Reset(FBBPlayerColumns& columns, const std::vector<uint32_t>& vecRows, size_t numSlots, double totalMoney)
+{
+    Prepare(columns, vecRows, totalMoney);
+    m_vecSlots.clear();
+    m_vecEligible.clear();
+    m_numSlots = numSlots;
+
+    std::vector<uint32_t> vecRemaining;
+    vecRemaining.reserve(m_remaining);
+    for (uint32_t row : vecRows) {
+        if (columns.owner[row] == 0) {
+            vecRemaining.push_back(row);
+        }
+    }
+
+    // Select the replacement player; everyone ahead of them is unordered
+    m_replacementZ = 0.f;
+    m_costPerZ = 0.f;
+    const size_t open = m_numSlots > m_numDrafted ? m_numSlots - m_numDrafted : 0;
+    if (open > 0 && open < vecRemaining.size()) {
+        const std::vector<float>& zScore = columns.zScore;
+        std::nth_element(vecRemaining.begin(), vecRemaining.begin() + open, vecRemaining.end(), ZScoreGreater{ zScore });
+        m_replacementZ = zScore[vecRemaining[open]];
+
+        double sumZ = 0;
+        for (size_t i = 0; i < open; i++) {
+            sumZ += zScore[vecRemaining[i]] - m_replacementZ;
+        }
+        const double money = std::max(0.0, m_totalMoney - m_spent);
+        m_costPerZ = sumZ > 0 ? float(money / sumZ) : 0.f;
+    }
+
+    columns.replacementZ = m_replacementZ;
+    columns.costPerZ = m_costPerZ;
+}
+
+void FBBValuation::Reset(FBBPlayerColumns& columns, const std::vector<uint32_t>& vecRows, const std::vector<FBBRosterSlots::Slot>& vecSlots, const std::vector<FBBPositionMask>& vecEligible, double totalMoney)
+{
+    Prepare(columns, vecRows, totalMoney);
+    m_vecSlots = vecSlots;
+    m_vecEligible = vecEligible;
+    m_numSlots = 0;
+    for (const FBBRosterSlots::Slot& slot : vecSlots) {
+        m_numSlots += slot.second;
+    }
+
+    // The assignment walks players best first
+    Rank();
+    Price();
+}
+
+void FBBValuation::Rank()
+{
+    if (m_ranked || !m_pColumns) {
+        return;
+    }
+
+    FBBPlayerColumns& columns = *m_pColumns;
+    std::sort(m_vecRanked.begin(), m_vecRanked.end(), ZScoreGreater{ columns.zScore });
+
+    // Build the trees in linear time from the undrafted players
+    const uint32_t count = static_cast<uint32_t>(m_vecRanked.size());
+    m_vecCount.assign(count + 1, 0);
+    m_vecSum.assign(count + 1, 0.0);
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t row = m_vecRanked[i];
+        columns.rank[row] = i + 1;
+        if (columns.owner[row] == 0) {
+            m_vecCount[i + 1] = 1;
+            m_vecSum[i + 1] = columns.zScore[row];
+        }
+    }
+    for (uint32_t i = 1; i <= count; i++) {
+        const uint32_t parent = i + (i & (0 - i));
+        if (parent <= count) {
+            m_vecCount[parent] += m_vecCount[i];
+            m_vecSum[parent] += m_vecSum[i];
+        }
+    }
+
+    m_ranked = true;
+}
+
+void FBBValuation::Draft(uint32_t row, uint32_t paid)
+{
+    if (!m_pColumns) {
+        return;
+    }
+
+    Rank();
+    m_numDrafted++;
+    m_spent += paid;
+
+    // Freeze their pre-pick estimate and leave the pool
+    const uint32_t rank = m_pColumns->rank[row];
+    if (rank != 0) {
+        m_pColumns->estimate[row] = (m_pColumns->zScore[row] + m_pColumns->scarcity[row] - m_replacementZ) * m_costPerZ;
+        Update(rank - 1, -1);
+    }
+
+    Price();
+}
+
+void FBBValuation::Undraft(uint32_t row, uint32_t paid)
+{
+    if (!m_pColumns) {
+        return;
+    }
+
+    Rank();
+    m_numDrafted = m_numDrafted > 0 ? m_numDrafted - 1 : 0;
+    m_spent -= paid;
+
+    const uint32_t rank = m_pColumns->rank[row];
+    if (rank != 0) {
+        Update(rank - 1, 1);
+    }
+
+    Price();
+}
+
+void FBBValuation::Update(uint32_t position, int32_t count)
+{
+    const double z = m_pColumns->zScore[m_vecRanked[position]];
+    const uint32_t size = static_cast<uint32_t>(m_vecRanked.size());
+    for (uint32_t i = position + 1; i <= size; i += i & (0 - i)) {
+        m_vecCount[i] += count;
+        m_vecSum[i] += count * z;
+    }
+    m_remaining += count;
+}
+
+uint32_t FBBValuation::FindRemaining(uint32_t k) const
+{
+    const uint32_t size = static_cast<uint32_t>(m_vecRanked.size());
+    uint32_t step = 1;
+    while (step * 2 <= size) {
+        step *= 2;
+    }
+
+    uint32_t position = 0;
+    int32_t left = static_cast<int32_t>(k);
+    for (; step; step /= 2) {
+        if (position + step <= size && m_vecCount[position + step] < left) {
+            position += step;
+            left -= m_vecCount[position];
+        }
+    }
+    return position;
+}
+
+double FBBValuation::SumBefore(uint32_t position) const
+{
+    double sum = 0;
+    for (uint32_t i = position; i > 0; i -= i & (0 - i)) {
+        sum += m_vecSum[i];
+    }
+    return sum;
+}
+
+void FBBValuation::Price()
+{
+    if (!m_vecSlots.empty()) {
+        return PriceByPosition();
+    }
+
+    m_replacementZ = 0.f;
+    m_costPerZ = 0.f;
+
+    // The first undrafted player that won't get a roster spot sets the
+    // replacement level. Everyone ahead of them splits the remaining money.
+    const size_t open = m_numSlots > m_numDrafted ? m_numSlots - m_numDrafted : 0;
+    if (open > 0 && open < m_remaining) {
+        const uint32_t replacement = FindRemaining(static_cast<uint32_t>(open) + 1);
+        m_replacementZ = m_pColumns->zScore[m_vecRanked[replacement]];
+
+        const double sumZ = SumBefore(replacement) - open * double(m_replacementZ);
+        const double money = std::max(0.0, m_totalMoney - m_spent);
+        m_costPerZ = sumZ > 0 ? float(money / sumZ) : 0.f;
+    }
+
+    m_pColumns->replacementZ = m_replacementZ;
+    m_pColumns->costPerZ = m_costPerZ;
+}
+
+void FBBValuation::PriceByPosition()
+{
+    FBBPlayerColumns& columns = *m_pColumns;
+    const std::vector<float>& zScore = columns.zScore;
+    m_replacementZ = 0.f;
+    m_costPerZ = 0.f;
+
+    // Drafted players hold on to their slots
+    FBBRosterSlots roster(m_vecSlots);
+    for (uint32_t row = 0; row < columns.Count(); row++) {
+        if (columns.owner[row] != 0) {
+            const FBBPositionMask drafted = columns.position[row];
+            roster.Place(row, drafted != FBB_POSITION_UNKNOWN ? drafted : m_vecEligible[row]);
+        }
+    }
+
+    // Fill the remaining slots best first. The first player left out at a
+    // position sets its replacement level.
+    std::vector<uint32_t> vecSelected;
+    float replacement[32] = {};
+    FBBPositionMask replaced = 0;
+    bool hasOverall = false;
+    for (uint32_t row : m_vecRanked) {
+        if (columns.owner[row] != 0) {
+            continue;
+        }
+
+        const FBBPositionMask eligible = m_vecEligible[row] & roster.Positions();
+        if (!roster.IsFull() && roster.Place(row, eligible)) {
+            vecSelected.push_back(row);
+            continue;
+        }
+
+        if (!hasOverall) {
+            m_replacementZ = zScore[row];
+            hasOverall = true;
+        }
+        for (uint32_t bit = 0; bit < 32; bit++) {
+            const FBBPositionMask position = 1u << bit;
+            if ((eligible & position) && !(replaced & position)) {
+                replacement[bit] = zScore[row];
+                replaced |= position;
+            }
+        }
+        if (roster.IsFull() && (replaced & roster.Positions()) == roster.Positions()) {
+            break;
+        }
+    }
+
+    // Everyone got a slot so nobody is worth anything extra
+    if (!hasOverall) {
+        columns.replacementZ = m_replacementZ;
+        columns.costPerZ = m_costPerZ;
+        return;
+    }
+
+    // Each player is measured against their scarcest position (the lowest
+    // replacement level), stored as a bonus on top of the overall level
+    for (uint32_t row : m_vecRanked) {
+        float level = m_replacementZ;
+        bool found = false;
+        for (uint32_t bit = 0; bit < 32; bit++) {
+            if ((m_vecEligible[row] & replaced) & (1u << bit)) {
+                level = found ? std::min(level, replacement[bit]) : replacement[bit];
+                found = true;
+            }
+        }
+        if (columns.owner[row] == 0) {
+            columns.scarcity[row] = m_replacementZ - level;
+        }
+    }
+
+    double sumZ = 0;
+    for (uint32_t row : vecSelected) {
+        sumZ += std::max(0.f, zScore[row] + columns.scarcity[row] - m_replacementZ);
+    }
+    const double money = std::max(0.0, m_totalMoney - m_spent);
+    m_costPerZ = sumZ > 0 ? float(money / sumZ) : 0.f;
+
+    columns.replacementZ = m_replacementZ;
+    columns.costPerZ = m_costPerZ;
+}
@@ -0,0 +1,235 @@
+#include "FBB/FBBWhatIf.h"
+#include "FBB/FBBCategory.h"
+#include "FBB/FBBPlayerStore.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+// Roto points of every owner in one category: one per owner beaten, ties split
+static void RotoPoints(const float* pValues, size_t stride, size_t numOwners, float* pPoints)
+{
+    for (size_t owner = 0; owner < numOwners; owner++) {
+        const float value = pValues[owner * stride];
+        float points = 1.f;
+        for (size_t other = 0; other < numOwners; other++) {
+            const float otherValue = pValues[other * stride];
+            if (otherValue < value) {
+                points += 1.f;
+            } else if (other != owner && otherValue == value) {
+                points += 0.5f;
+            }
+        }
+        pPoints[owner * stride] = points;
+    }
+}
+
+// Undrafted players still expected to go, averaged into the open slots
+static bool IsFill(const FBBPlayerColumns& columns, uint32_t row)
+{
+    return columns.owner[row] == 0 && columns.pooled[row] && columns.zScore[row] + columns.scarcity[row] > columns.replacementZ;
+}
+
+static float CategoryValue(const FBBCategory* pCategory, double num, double den)
+{
+    const double value = pCategory->IsRate() ? (den > 0 ? num / den : 0.0) : num;
+    return float(pCategory->sign * value);
+}
+
+std::shared_ptr<const FBBWhatIf::Snapshot> FBBWhatIf::Capture(const FBBPlayerStore& store, const FBBLeaugeSettings& settings, const FBBInflation& inflation)
+{
+    std::shared_ptr<Snapshot> spSnapshot = std::make_shared<Snapshot>();
+    Snapshot& snapshot = *spSnapshot;
+    snapshot.pStore = &store;
+    snapshot.inflation = inflation;
+
+    for (const auto& owner : settings.owners) {
+        snapshot.mapOwners[owner.first] = static_cast<uint32_t>(snapshot.vecOwners.size());
+        snapshot.vecOwners.push_back(owner.first);
+    }
+    const size_t numOwners = snapshot.vecOwners.size();
+
+    snapshot.vecCategories = FBBEnabledCategories(FBBPlayer::PLAYER_TYPE_HITTER, settings.categories);
+    snapshot.firstPitching = snapshot.vecCategories.size();
+    for (const FBBCategory* pCategory : FBBEnabledCategories(FBBPlayer::PLAYER_TYPE_PITCHER, settings.categories)) {
+        snapshot.vecCategories.push_back(pCategory);
+    }
+    const size_t numCategories = snapshot.vecCategories.size();
+
+    snapshot.vecFillNum.assign(numCategories, 0.0);
+    snapshot.vecFillDen.assign(numCategories, 0.0);
+    snapshot.vecNum.assign(numOwners * numCategories, 0.0);
+    snapshot.vecDen.assign(numOwners * numCategories, 0.0);
+    snapshot.vecOpenHitters.assign(numOwners, 0);
+    snapshot.vecOpenPitchers.assign(numOwners, 0);
+    snapshot.vecOpenBench.assign(numOwners, settings.positions.numBench);
+
+    for (FBBPlayer::PlayerType type : { FBBPlayer::PLAYER_TYPE_HITTER, FBBPlayer::PLAYER_TYPE_PITCHER }) {
+        const bool isHitter = type == FBBPlayer::PLAYER_TYPE_HITTER;
+        const size_t begin = isHitter ? 0 : snapshot.firstPitching;
+        const size_t end = isHitter ? snapshot.firstPitching : numCategories;
+        const FBBPlayerColumns& columns = store.Columns(type);
+
+        // Sum the rosters, and the players still worth buying for the fill
+        std::vector<uint32_t> vecRostered(numOwners, 0);
+        uint32_t numFill = 0;
+        for (uint32_t row = 0; row < columns.Count(); row++) {
+            double* pNum = nullptr;
+            double* pDen = nullptr;
+            if (columns.owner[row] != 0) {
+                auto itr = snapshot.mapOwners.find(columns.owner[row]);
+                if (itr == snapshot.mapOwners.end()) {
+                    continue;
+                }
+                vecRostered[itr->second]++;
+                pNum = snapshot.vecNum.data() + itr->second * numCategories;
+                pDen = snapshot.vecDen.data() + itr->second * numCategories;
+            } else if (IsFill(columns, row)) {
+                numFill++;
+                pNum = snapshot.vecFillNum.data();
+                pDen = snapshot.vecFillDen.data();
+            } else {
+                continue;
+            }
+
+            for (size_t k = begin; k < end; k++) {
+                const FBBCategory* pCategory = snapshot.vecCategories[k];
+                pNum[k] += pCategory->numerator(columns, row);
+                if (pCategory->IsRate()) {
+                    pDen[k] += pCategory->denominator(columns, row);
+                }
+            }
+        }
+
+        (isHitter ? snapshot.numFillHitters : snapshot.numFillPitchers) = numFill;
+        for (size_t k = begin; k < end && numFill > 0; k++) {
+            snapshot.vecFillNum[k] /= numFill;
+            snapshot.vecFillDen[k] /= numFill;
+        }
+
+        // Open slots are filled with the average player left
+        const uint32_t teamSize = isHitter ? settings.SumHitters() : settings.SumPitchers();
+        std::vector<uint32_t>& vecOpen = isHitter ? snapshot.vecOpenHitters : snapshot.vecOpenPitchers;
+        for (size_t owner = 0; owner < numOwners; owner++) {
+            vecOpen[owner] = teamSize > vecRostered[owner] ? teamSize - vecRostered[owner] : 0;
+
+            // Anyone past a full roster sits on the bench
+            const uint32_t benched = vecRostered[owner] > teamSize ? vecRostered[owner] - teamSize : 0;
+            snapshot.vecOpenBench[owner] -= std::min(benched, snapshot.vecOpenBench[owner]);
+            for (size_t k = begin; k < end; k++) {
+                snapshot.vecNum[owner * numCategories + k] += vecOpen[owner] * snapshot.vecFillNum[k];
+                snapshot.vecDen[owner * numCategories + k] += vecOpen[owner] * snapshot.vecFillDen[k];
+            }
+        }
+    }
+
+    // Projected standings
+    snapshot.vecValues.resize(numOwners * numCategories);
+    snapshot.vecPoints.resize(numOwners * numCategories);
+    snapshot.vecTotals.assign(numOwners, 0.f);
+    for (size_t i = 0; i < snapshot.vecValues.size(); i++) {
+        snapshot.vecValues[i] = CategoryValue(snapshot.vecCategories[i % numCategories], snapshot.vecNum[i], snapshot.vecDen[i]);
+    }
+    for (size_t k = 0; k < numCategories; k++) {
+        RotoPoints(snapshot.vecValues.data() + k, numCategories, numOwners, snapshot.vecPoints.data() + k);
+    }
+    for (size_t i = 0; i < snapshot.vecPoints.size(); i++) {
+        snapshot.vecTotals[i / numCategories] += snapshot.vecPoints[i];
+    }
+
+    return spSnapshot;
+}
+
+std::vector<FBBWhatIf::Result> FBBWhatIf::Evaluate(const std::shared_ptr<const Snapshot>& spSnapshot, const std::vector<Purchase>& vecPurchases)
+{
+    std::vector<Result> ret(vecPurchases.size());
+    for (size_t i = 0; i < ret.size(); i++) {
+        ret[i].purchase = vecPurchases[i];
+    }
+
+    if (spSnapshot) {
+        const Snapshot& snapshot = *spSnapshot;
+        QtConcurrent::blockingMap(ret, [&snapshot](Result& result) {
+            Evaluate(snapshot, result);
+        });
+    }
+    return ret;
+}
+
+void FBBWhatIf::Evaluate(const Snapshot& snapshot, Result& result)
+{
+    const Purchase& purchase = result.purchase;
+    const FBBPlayer* pPlayer = purchase.pPlayer;
+    auto itr = snapshot.mapOwners.find(purchase.owner);
+    if (!pPlayer || pPlayer->Owner() != 0 || itr == snapshot.mapOwners.end()) {
+        return;
+    }
+
+    const size_t buyer = itr->second;
+    const size_t numOwners = snapshot.vecOwners.size();
+    const size_t numCategories = snapshot.vecCategories.size();
+    const bool isHitter = pPlayer->Type() == FBBPlayer::PLAYER_TYPE_HITTER;
+    const size_t begin = isHitter ? 0 : snapshot.firstPitching;
+    const size_t end = isHitter ? snapshot.firstPitching : numCategories;
+    const uint32_t open = isHitter ? snapshot.vecOpenHitters[buyer] : snapshot.vecOpenPitchers[buyer];
+    const FBBPlayerColumns& columns = snapshot.pStore->Columns(pPlayer->Type());
+    const uint32_t row = pPlayer->Row();
+    const std::vector<uint32_t>& vecOpen = isHitter ? snapshot.vecOpenHitters : snapshot.vecOpenPitchers;
+    const uint32_t numFill = isHitter ? snapshot.numFillHitters : snapshot.numFillPitchers;
+    const bool isFill = IsFill(columns, row) && numFill > 0;
+
+    // With no open slot the player joins the bench, if there's room
+    if (open == 0 && snapshot.vecOpenBench[buyer] == 0) {
+        return;
+    }
+
+    // The player takes one of the buyer's open slots, or joins the bench and
+    // doesn't score. If they were part of the fill average, every owner's
+    // open slots are refilled from the players left without them.
+    std::vector<float> vecTotals = snapshot.vecTotals;
+    std::vector<float> vecValues(numOwners);
+    std::vector<float> vecPoints(numOwners);
+    for (size_t k = begin; k < end; k++) {
+        const FBBCategory* pCategory = snapshot.vecCategories[k];
+        const double playerNum = pCategory->numerator(columns, row);
+        const double playerDen = pCategory->IsRate() ? pCategory->denominator(columns, row) : 0.0;
+
+        double fillNum = snapshot.vecFillNum[k];
+        double fillDen = snapshot.vecFillDen[k];
+        if (isFill) {
+            fillNum = numFill > 1 ? (fillNum * numFill - playerNum) / (numFill - 1) : 0.0;
+            fillDen = numFill > 1 ? (fillDen * numFill - playerDen) / (numFill - 1) : 0.0;
+        }
+        const double deltaNum = fillNum - snapshot.vecFillNum[k];
+        const double deltaDen = fillDen - snapshot.vecFillDen[k];
+
+        for (size_t owner = 0; owner < numOwners; owner++) {
+            if (isFill || owner == buyer) {
+                double num = snapshot.vecNum[owner * numCategories + k] + vecOpen[owner] * deltaNum;
+                double den = snapshot.vecDen[owner * numCategories + k] + vecOpen[owner] * deltaDen;
+                if (owner == buyer && open > 0) {
+                    num += playerNum - fillNum;
+                    den += playerDen - fillDen;
+                }
+                vecValues[owner] = CategoryValue(pCategory, num, den);
+            } else {
+                vecValues[owner] = snapshot.vecValues[owner * numCategories + k];
+            }
+        }
+        RotoPoints(vecValues.data(), 1, numOwners, vecPoints.data());
+        for (size_t owner = 0; owner < numOwners; owner++) {
+            vecTotals[owner] += vecPoints[owner] - snapshot.vecPoints[owner * numCategories + k];
+        }
+    }
+
+    result.points = vecTotals[buyer] - snapshot.vecTotals[buyer];
+    result.place = 1;
+    for (size_t owner = 0; owner < numOwners; owner++) {
+        result.place += vecTotals[owner] > vecTotals[buyer] ? 1 : 0;
+    }
+
+    FBBInflation inflation = snapshot.inflation;
+    inflation.Draft(pPlayer->BaseValue(), purchase.price);
+    result.inflation = inflation.Factor() - snapshot.inflation.Factor();
+    result.surplus = pPlayer->BaseValue() * snapshot.inflation.Factor() - purchase.price;
+}